@@ -18,27 +18,49 @@
 #include "FileSystem.h"
 #include "GameObjectFactory.h"
 #include "GameplaySystem.h"
-#include "GraphicsSystem.h"
 #include "MessagesGraphicsSystem.h"
+#include "MessagesInput.h"
+#include "NullGraphicsSystem.h"
 #include "PhysicsSystem.h"
 #include "WorldManager.h"
 #include <imgui.h>
+#include <chrono>
+#include <stdlib.h>
+#include <string.h>
+
+#if PLATFORM_WIN32
+#include "GraphicsSystem.h"
 #include <imgui_impl_win32.h>
 #include <imgui_impl_dx11.h>
+#endif
 
 static App* gAppPtr = nullptr;
 
+#if PLATFORM_WIN32
 static const char* winClassName = "Window";
+#endif
 static const std::string Path_AssetFolder = "../../Assets/";
 
 App::App(void)
 	: Singleton(this)
 	, m_appStateIsRunning(false)
-	, m_input(this)
+	, m_numWaves(0U)
 	, m_ini(nullptr)
+	, m_input(this)
+	, m_GOF(nullptr)
 	, m_running(false)
+	, m_exitAfterPlayback(false)
+	, m_headless(false)
+	, m_headlessFrames(0U)
+	, m_headlessDeltaTime(0.0f)
+	, m_simulationStep(0.0f)
+	, m_maxSimulationSteps(0U)
+	, m_accumulator(0.0f)
+	, m_simulationTick(0U)
+	, m_interpolationAlpha(1.0f)
+#if PLATFORM_WIN32
 	, m_hInstance(nullptr)
-	, m_GOF(nullptr)
+#endif
 {
 	gAppPtr = this;
 	m_GOF = new GameObjectFactory(m_messenger);
@@ -53,6 +75,7 @@ App::~App(void)
 	gAppPtr = nullptr;
 }
 
+#if PLATFORM_WIN32
 // Forward declare message handler from imgui_impl_win32.cpp
 extern IMGUI_IMPL_API LRESULT ImGui_ImplWin32_WndProcHandler(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
@@ -90,10 +113,11 @@ LRESULT App::WindowProcedure(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 
 	return DefWindowProc(hwnd, uMsg, wParam, lParam);
 }
+#endif
 
-bool App::InitializeApp(void)
+bool App::InitializeApp(int argc, char** argv)
 {
-	if (m_hInstance != nullptr)
+	if (m_ini != nullptr)
 	{
 		fprintf(stderr, "App::%s: App instance is already initialized\n", __func__);
 		return true;
@@ -104,26 +128,37 @@ bool App::InitializeApp(void)
 	m_windowSize.x = static_cast<float>(m_ini->GetInteger("App", "WindowSizeX", 800));
 	m_windowSize.y = static_cast<float>(m_ini->GetInteger("App", "WindowSizeY", 600));
 
-	std::string windowName = m_ini->Get("App", "WindowName", "Default");
-	m_frameCounter.SetFPSLock(m_ini->GetInteger("App", "FPSLock", 0));
+	m_jobSystem.Initialize(m_ini->GetInteger("App", "WorkerThreads", -1));
 
-	WNDCLASS winClassData = {};
-	{
-		winClassData.lpszClassName = winClassName;
-		m_hInstance = winClassData.hInstance = GetModuleHandle(nullptr);
-		winClassData.lpfnWndProc = &WindowProcedure;
-		winClassData.style = CS_DBLCLKS;
-	}
+	m_headless = m_ini->GetBoolean("App", "Headless", false);
+	m_headlessFrames = static_cast<uint32_t>(m_ini->GetInteger("App", "HeadlessFrames", 600));
+	long headlessFrameRate = m_ini->GetInteger("App", "HeadlessFrameRate", 60);
+	m_headlessDeltaTime = 1.0f / static_cast<float>(headlessFrameRate > 0 ? headlessFrameRate : 60);
 
-	ATOM registered = RegisterClass(&winClassData);
-	if (!registered)
+	long simulationRate = m_ini->GetInteger("App", "SimulationRate", 0);
+	m_simulationStep = simulationRate > 0 ? 1.0f / static_cast<float>(simulationRate) : 0.0f;
+	m_maxSimulationSteps = static_cast<uint32_t>(m_ini->GetInteger("App", "MaxSimulationSteps", 8));
+	ReadCommandLine(argc, argv);
+#if !PLATFORM_WIN32
+	m_headless = true;	// window and D3D11 backend are Win32 only
+#endif
+
+	/* Headless frames are not locked, they run as fast as possible */
+	m_frameCounter.SetFPSLock(m_headless ? 0U : static_cast<uint32_t>(m_ini->GetInteger("App", "FPSLock", 0)));
+	m_frameCounter.SetHistorySize(static_cast<uint32_t>(m_ini->GetInteger("App", "FrameHistory", 1000)));
+	m_frameCounter.SetHitchThreshold(static_cast<float>(m_ini->GetReal("App", "HitchThreshold", 50.0)));
+
+#if PLATFORM_WIN32
+	if (!m_headless)
 	{
-		DWORD error = GetLastError();
-		fprintf(stderr, "App::%s: Failed to register window class. Error %lu\n", __func__, error);
-		return false;
+		std::string windowName = m_ini->Get("App", "WindowName", "Default");
+		bool created = CreateAppWindow(windowName);
+		if (!created)
+		{
+			return false;
+		}
 	}
-
-	m_window.Create(winClassData, windowName.c_str(), 0, 0, static_cast<int>(m_windowSize.x), static_cast<int>(m_windowSize.y));
+#endif
 
 	// ImGui setup
 	// Setup Dear ImGui context
@@ -138,7 +173,24 @@ bool App::InitializeApp(void)
 	//ImGui::StyleColorsClassic();
 
 	// Setup Platform/Renderer backends
-	ImGui_ImplWin32_Init(m_window.GetHandle());
+	if (m_headless)
+	{ // no backends: UI is still built every frame, draw data is dropped
+		io.IniFilename = nullptr;
+		io.DisplaySize = ImVec2(m_windowSize.x, m_windowSize.y);
+		io.Fonts->Build();
+	}
+#if PLATFORM_WIN32
+	else
+	{
+		ImGui_ImplWin32_Init(m_window.GetHandle());
+	}
+#endif
+
+	m_messenger.SetJournal(&m_journal);
+	// per-type times are shown by the debug overlay and written to the stats file
+	m_messenger.SetTimingEnabled(DEBUG_OVERLAY || !m_ini->Get("App", "MessengerStatsFile", "").empty());
+	m_journal.RegisterType<InputMessage>("InputMessage");
+	m_journal.RegisterType<WindowResizeMessage>("WindowResizeMessage");
 
 	/* Create and initialize default systems and app components */
 	CreateSystems();
@@ -150,13 +202,106 @@ bool App::InitializeApp(void)
 		return false;
 	}
 
-	m_window.Show();
+	/* Journal: replay takes precedence, both are off unless set */
+	std::string journalReplay = m_ini->Get("App", "JournalReplay", "");
+	std::string journalRecord = m_ini->Get("App", "JournalRecord", "");
+	if (!journalReplay.empty())
+	{
+		m_journal.StartReplay(journalReplay);
+	}
+	else if (!journalRecord.empty())
+	{
+		m_journal.StartRecording(journalRecord);
+	}
+
+	/* Profiler trace: frames TraceFirstFrame to TraceLastFrame, 0 traces until exit */
+	std::string traceFile = m_ini->Get("Profiler", "TraceFile", "");
+	if (!traceFile.empty())
+	{
+		uint64_t firstFrame = static_cast<uint64_t>(m_ini->GetInteger("Profiler", "TraceFirstFrame", 0));
+		uint64_t lastFrame = static_cast<uint64_t>(m_ini->GetInteger("Profiler", "TraceLastFrame", 0));
+		m_profiler.StartTrace(traceFile, firstFrame, lastFrame);
+	}
+
+	/* Input recording: a played back session exits the app when it ends */
+	std::string inputPlayback = m_ini->Get("App", "InputPlayback", "");
+	std::string inputRecord = m_ini->Get("App", "InputRecord", "");
+	if (!inputPlayback.empty())
+	{
+		m_exitAfterPlayback = m_input.GetRecorder().StartPlayback(inputPlayback);
+	}
+	else if (!inputRecord.empty())
+	{
+		m_input.GetRecorder().StartRecording(inputRecord);
+	}
+
+	if (m_headless)
+	{ // systems get the size a window would report when shown
+		WindowResizeMessage msg(static_cast<uint32_t>(m_windowSize.x), static_cast<uint32_t>(m_windowSize.y));
+		m_messenger.Send(msg);
+	}
+#if PLATFORM_WIN32
+	else
+	{
+		m_window.Show();
+	}
+#endif
 
 	return true;
 }
 
+void App::ReadCommandLine(int argc, char** argv)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "-headless") == 0)
+		{
+			m_headless = true;
+		}
+		else if (strcmp(argv[i], "-frames") == 0 && i + 1 < argc)
+		{
+			m_headlessFrames = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+		}
+		else
+		{
+			fprintf(stderr, "App::%s: unknown option \"%s\"\n", __func__, argv[i]);
+		}
+	}
+}
+
+#if PLATFORM_WIN32
+bool App::CreateAppWindow(const std::string& windowName)
+{
+	WNDCLASS winClassData = {};
+	{
+		winClassData.lpszClassName = winClassName;
+		m_hInstance = winClassData.hInstance = GetModuleHandle(nullptr);
+		winClassData.lpfnWndProc = &WindowProcedure;
+		winClassData.style = CS_DBLCLKS;
+	}
+
+	ATOM registered = RegisterClass(&winClassData);
+	if (!registered)
+	{
+		DWORD error = GetLastError();
+		fprintf(stderr, "App::%s: Failed to register window class. Error %lu\n", __func__, error);
+		return false;
+	}
+
+	m_window.Create(winClassData, windowName.c_str(), 0, 0, static_cast<int>(m_windowSize.x), static_cast<int>(m_windowSize.y));
+	return true;
+}
+#endif
+
 void App::Update(void)
 {
+	if (m_headless)
+	{
+		UpdateHeadless();
+		return;
+	}
+
+#if PLATFORM_WIN32
 	if (m_window.GetHandle() != nullptr)
 	{
 		m_running = true;
@@ -182,40 +327,154 @@ void App::Update(void)
 			TranslateMessage(&message);
 			DispatchMessage(&message);
 		}
-		m_input.Finalize();
-		m_messenger.Dispatch();
-		UpdateSystems(m_frameCounter.GetDelta());
+		m_profiler.BeginFrame();
+		UpdateFrame(m_frameCounter.GetDelta());
+		m_profiler.EndFrame();
+		m_frameCounter.Finish();
+		RecordHitch();
+	}
+#endif
+}
+
+void App::UpdateHeadless(void)
+{
+	m_running = true;
+	ImGuiIO& io = ImGui::GetIO();
+
+	uint32_t numFrames = 0U;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	while (m_running && (m_headlessFrames == 0U || numFrames < m_headlessFrames))
+	{
+		/* UI gets the last frame's input, window events reach it a frame late as well */
+		const KeyStates& keys = m_input.GetFrameKeyState();
+		const MouseCoordinates& mouse = m_input.GetFrameMouseCoordinates();
+		io.AddMousePosEvent(static_cast<float>(mouse.x), static_cast<float>(mouse.y));
+		io.AddMouseButtonEvent(ImGuiMouseButton_Left, keys.IsDown(VK_LBUTTON));
+		io.AddMouseButtonEvent(ImGuiMouseButton_Right, keys.IsDown(VK_RBUTTON));
+		io.AddMouseButtonEvent(ImGuiMouseButton_Middle, keys.IsDown(VK_MBUTTON));
+
+		io.DeltaTime = m_headlessDeltaTime;
+		ImGui::NewFrame();
+		m_frameCounter.Start();
+		m_profiler.BeginFrame();
+		UpdateFrame(m_headlessDeltaTime);
+		m_profiler.EndFrame();
 		m_frameCounter.Finish();
+		RecordHitch();
+		++numFrames;
 	}
+	std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+	double frameTime = numFrames > 0U ? elapsed.count() / numFrames : 0.0;
+	printf("App::%s: %u frames in %.1f ms, %.3f ms per frame\n", __func__, numFrames, elapsed.count(), frameTime);
+
+	FrameStats stats = m_frameCounter.GetStats();
+	printf("App::%s: last %u frames: p50 %.3f ms, p95 %.3f ms, p99 %.3f ms, max %.3f ms, %zu hitches\n", __func__,
+		stats.m_numFrames, stats.m_p50, stats.m_p95, stats.m_p99, stats.m_max, m_frameCounter.GetHitches().size());
+}
+
+void App::UpdateFrame(float frameTime)
+{
+	PROFILE_SCOPE("App::Update");
+	float deltaTime = m_input.Finalize(frameTime);
+	if (m_exitAfterPlayback && !m_input.GetRecorder().IsPlaying())
+	{ // recorded session is over, this frame runs on live input
+		NotifyExit();
+	}
+	m_messenger.Dispatch();
+	m_jobSystem.RunMainThreadJobs();
+	ShowDebugOverlay();
+
+	BuildSchedule();
+	UpdateSystemsUI(deltaTime);
+	Simulate(deltaTime);
+	UpdateSystems(deltaTime, false);
+}
+
+void App::Simulate(float deltaTime)
+{
+	PROFILE_SCOPE("App::Simulate");
+	if (m_simulationStep <= 0.0f)
+	{ // lockstep: one tick per frame, nothing to interpolate
+		++m_simulationTick;
+		UpdateSystems(deltaTime, true);
+		m_interpolationAlpha = 1.0f;
+		return;
+	}
+
+	m_accumulator += deltaTime;
+	uint32_t numSteps = 0U;
+	while (m_accumulator >= m_simulationStep)
+	{
+		if (numSteps == m_maxSimulationSteps)
+		{ // simulation cannot keep up, slow it down instead of falling further behind
+			m_accumulator = 0.0f;
+			break;
+		}
+
+		++m_simulationTick;
+		UpdateSystems(m_simulationStep, true);
+		m_accumulator -= m_simulationStep;
+		++numSteps;
+	}
+
+	m_interpolationAlpha = m_accumulator / m_simulationStep;
 }
 
 void App::Exit(void)
 {
-	if (m_hInstance == nullptr)
+	if (m_ini == nullptr)
 	{
 		return;
 	}
 
 	ExitSystems();
+	m_jobSystem.Shutdown();
+	m_profiler.StopTrace();
+	m_journal.Stop();
+	m_input.GetRecorder().Stop();
 
-	ImGui_ImplWin32_Shutdown();
+	std::string messengerStatsFile = m_ini->Get("App", "MessengerStatsFile", "");
+	if (!messengerStatsFile.empty())
+	{
+		m_messenger.WriteStatisticsCSV(messengerStatsFile);
+	}
+
+	std::string frameStatsFile = m_ini->Get("App", "FrameStatsFile", "");
+	if (!frameStatsFile.empty())
+	{
+		m_frameCounter.WriteStatisticsCSV(frameStatsFile);
+	}
+
+#if PLATFORM_WIN32
+	if (!m_headless)
+	{
+		ImGui_ImplWin32_Shutdown();
+	}
+#endif
 	ImGui::DestroyContext();
 
 	m_input.Reset();
-	m_window.Destroy();
 
-	BOOL success = UnregisterClass(winClassName, m_hInstance);
-	if (!success)
+#if PLATFORM_WIN32
+	if (m_hInstance != nullptr)
 	{
-		DWORD error = GetLastError();
-		fprintf(stderr, "App::%s: Failed to unregister window class. Error %lu\n", __func__, error);
-		return;
+		m_window.Destroy();
+
+		BOOL success = UnregisterClass(winClassName, m_hInstance);
+		if (!success)
+		{
+			DWORD error = GetLastError();
+			fprintf(stderr, "App::%s: Failed to unregister window class. Error %lu\n", __func__, error);
+			return;
+		}
+		m_hInstance = nullptr;
 	}
+#endif
 
 	delete m_ini;
 	m_ini = nullptr;
 	m_running = false;
-	m_hInstance = nullptr;
 }
 
 Messenger& App::GetMessenger(void)
@@ -223,10 +482,22 @@ Messenger& App::GetMessenger(void)
 	return m_messenger;
 }
 
+MessageJournal& App::GetMessageJournal(void)
+{
+	return m_journal;
+}
+
+JobSystem& App::GetJobSystem(void)
+{
+	return m_jobSystem;
+}
+
+#if PLATFORM_WIN32
 const Window& App::GetWindow(void) const
 {
 	return m_window;
 }
+#endif
 
 const Vector2& App::GetWindowSize(void) const
 {
@@ -238,6 +509,21 @@ const std::string& App::GetAssetPath(void) const
 	return m_assetPath;
 }
 
+bool App::IsHeadless(void) const
+{
+	return m_headless;
+}
+
+uint64_t App::GetSimulationTick(void) const
+{
+	return m_simulationTick;
+}
+
+float App::GetInterpolationAlpha(void) const
+{
+	return m_interpolationAlpha;
+}
+
 void App::NotifyExit(void)
 {
 	m_running = false;
@@ -247,7 +533,14 @@ void App::CreateSystems(void)
 {
 	CreateSystem<FileSystem>();
 	CreateSystem<PhysicsSystem>();
-	CreateSystem<GraphicsSystem>();
+#if PLATFORM_WIN32
+	if (!m_headless)
+	{
+		CreateSystem<GraphicsSystem>();
+		return;
+	}
+#endif
+	CreateSystem<NullGraphicsSystem>();
 }
 
 void App::RegisterMessages(void) const
@@ -282,14 +575,198 @@ bool App::InitializeSystems(void)
 	return true;
 }
 
-void App::UpdateSystems(float deltaTime)
+void App::UpdateSystemsUI(float deltaTime)
 {
 	for (ISystem* system : m_systems)
 	{
-		system->Update(deltaTime);
+		system->UpdateUI(deltaTime);
+	}
+
+	m_GOF->FlushCommands();
+}
+
+void App::UpdateSystems(float deltaTime, bool simulation)
+{
+	for (uint32_t wave = 0U; wave < m_numWaves; ++wave)
+	{
+		JobCounter counter;
+		for (ScheduledSystem& entry : m_schedule)
+		{
+			if (entry.m_wave == wave && !entry.m_access.m_mainThread && entry.m_access.m_simulation == simulation)
+			{
+				ScheduledSystem* entryPtr = &entry;
+				m_jobSystem.Schedule([this, entryPtr, deltaTime]() { UpdateScheduledSystem(*entryPtr, deltaTime); }, &counter);
+			}
+		}
+
+		for (ScheduledSystem& entry : m_schedule)
+		{
+			if (entry.m_wave == wave && entry.m_access.m_mainThread && entry.m_access.m_simulation == simulation)
+			{
+				UpdateScheduledSystem(entry, deltaTime);
+			}
+		}
+
+		m_jobSystem.Wait(counter);
+		// sync point: queue the wave's messages in schedule order, whichever thread ran the systems, and apply object changes
+		for (ScheduledSystem& entry : m_schedule)
+		{
+			if (entry.m_wave == wave && entry.m_access.m_simulation == simulation)
+			{
+				m_messenger.MergeOutbox(entry.m_outbox);
+			}
+		}
+		m_GOF->FlushCommands();
+	}
+}
+
+void App::BuildSchedule(void)
+{
+	size_t numSystems = m_systems.size();
+	bool isChanged = m_schedule.size() != numSystems;
+	m_schedule.resize(numSystems);
+
+	for (size_t i = 0U; i < numSystems; ++i)
+	{
+		ScheduledSystem& entry = m_schedule[i];
+		entry.m_system = m_systems[i];
+		entry.m_updateTime = 0.0f;
+
+		/* Access is kept between frames, systems usually declare the same one again */
+		SystemAccess& access = entry.m_access;
+		bool writesAll = access.m_writesAll;
+		bool mainThread = access.m_mainThread;
+		bool simulation = access.m_simulation;
+		size_t numReads = access.m_reads.size();
+		size_t numWrites = access.m_writes.size();
+		entry.m_system->DeclareAccess(access);
+		isChanged = isChanged || access.m_writesAll != writesAll || access.m_mainThread != mainThread || access.m_simulation != simulation
+			|| access.m_reads.size() != numReads || access.m_writes.size() != numWrites;
+	}
+
+	if (!isChanged)
+	{
+		return;
+	}
+
+	m_numWaves = 0U;
+	for (size_t i = 0U; i < numSystems; ++i)
+	{
+		ScheduledSystem& entry = m_schedule[i];
+
+		/* Conflicting systems keep their creation order */
+		entry.m_wave = 0U;
+		for (size_t j = 0U; j < i; ++j)
+		{
+			const ScheduledSystem& earlier = m_schedule[j];
+			if (earlier.m_wave >= entry.m_wave && earlier.m_access.ConflictsWith(entry.m_access))
+			{
+				entry.m_wave = earlier.m_wave + 1U;
+			}
+		}
+
+		if (entry.m_wave >= m_numWaves)
+		{
+			m_numWaves = entry.m_wave + 1U;
+		}
+	}
+}
+
+void App::UpdateScheduledSystem(ScheduledSystem& entry, float deltaTime)
+{
+	PROFILE_SCOPE(entry.m_system->GetName());
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	Messenger::Outbox* previousOutbox = Messenger::BindOutbox(&entry.m_outbox);
+	entry.m_system->Update(deltaTime);
+	Messenger::BindOutbox(previousOutbox);
+	std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+	entry.m_updateTime += elapsed.count();
+}
+
+void App::RecordHitch(void)
+{
+	if (!m_frameCounter.IsHitch())
+	{
+		return;
+	}
+
+	const ScheduledSystem* slowest = nullptr;
+	for (const ScheduledSystem& entry : m_schedule)
+	{
+		if (slowest == nullptr || entry.m_updateTime > slowest->m_updateTime)
+		{
+			slowest = &entry;
+		}
+	}
+
+	if (slowest != nullptr)
+	{
+		m_frameCounter.AddHitch(slowest->m_system->GetName(), slowest->m_updateTime);
+	}
+	else
+	{
+		m_frameCounter.AddHitch("", 0.0f);
 	}
 }
 
+void App::ShowDebugOverlay(void)
+{
+#if DEBUG_OVERLAY
+	m_GOF->ShowPoolStatistics();
+	m_worldManager->ShowArenaStatistics();
+	ShowSystemSchedule();
+	m_messenger.ShowStatistics();
+	m_frameCounter.ShowStatistics();
+#if PROFILER_ENABLED
+	m_profiler.ShowFlameGraph();
+#endif
+#endif
+}
+
+void App::ShowSystemSchedule(void) const
+{
+	ImGui::Begin("System Schedule");
+	ImGui::Text("Workers: %u", m_jobSystem.GetNumWorkers());
+	ImGui::Text("Simulation tick: %llu, alpha %.2f", static_cast<unsigned long long>(m_simulationTick), m_interpolationAlpha);
+
+	if (ImGui::BeginTable("Schedule", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+	{
+		ImGui::TableSetupColumn("Wave");
+		ImGui::TableSetupColumn("System");
+		ImGui::TableSetupColumn("Thread");
+		ImGui::TableSetupColumn("Rate");
+		ImGui::TableSetupColumn("Time (ms)");
+		ImGui::TableHeadersRow();
+
+		for (uint32_t wave = 0U; wave < m_numWaves; ++wave)
+		{
+			for (const ScheduledSystem& entry : m_schedule)
+			{
+				if (entry.m_wave != wave)
+				{
+					continue;
+				}
+
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::Text("%u", wave);
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(entry.m_system->GetName());
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(entry.m_access.m_mainThread ? "Main" : "Worker");
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(entry.m_access.m_simulation ? "Tick" : "Frame");
+				ImGui::TableNextColumn();
+				ImGui::Text("%.3f", entry.m_updateTime);
+			}
+		}
+
+		ImGui::EndTable();
+	}
+
+	ImGui::End();
+}
+
 void App::ExitSystems(void)
 {
 	for (ISystem* system : m_systems)
@@ -17,14 +17,24 @@
 #define APP_H
 
 #include "ISystem.h"
+#include "Platform.h"
 #include "Singleton.h"
 #include "Window.h"
 #include "Input.h"
 #include "Messenger.h"
+#include "MessageJournal.h"
 #include "FrameCounter.h"
+#include "JobSystem.h"
+#include "Profiler.h"
 #include "Vector2.h"
 #include <vector>
 
+#ifdef _DEBUG
+#define DEBUG_OVERLAY 1
+#else
+#define DEBUG_OVERLAY 0
+#endif
+
 class GameObjectFactory;
 class WorldManager;
 
@@ -34,17 +44,30 @@ public:
 	App(void);
 	~App(void);
 
+#if PLATFORM_WIN32
 	static LRESULT WindowProcedure(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+#endif
 
+	/* Initialize: command line options override Settings.ini,
+	-headless runs without a window, -frames N sets the number of frames a headless run updates */
 	template<typename ClientGameplaySystemType>
-	bool Initialize(void);
+	bool Initialize(int argc = 0, char** argv = nullptr);
 	void Update(void);
 	void Exit(void);
 
 	Messenger& GetMessenger(void);
+	MessageJournal& GetMessageJournal(void);	// systems register their journaled message types in Initialize
+	JobSystem& GetJobSystem(void);
+#if PLATFORM_WIN32
 	const Window& GetWindow(void) const;
+#endif
 	const Vector2& GetWindowSize(void) const;
 	const std::string& GetAssetPath(void) const;
+	bool IsHeadless(void) const;	// no window, NullGraphicsSystem renders
+
+	/* Simulation: systems declaring m_simulation update on a fixed tick, rendering interpolates between ticks */
+	uint64_t GetSimulationTick(void) const;	// ticks run so far, the running tick while simulating
+	float GetInterpolationAlpha(void) const;	// how far the frame is past the last tick, in ticks. 1 without a fixed tick
 
 	void NotifyExit(void);
 
@@ -52,23 +75,54 @@ public:
 	bool m_appStateIsRunning; // controlling variable for pause/resume. False for pause.
 
 private:
-	bool InitializeApp(void);
+	bool InitializeApp(int argc, char** argv);
+	void ReadCommandLine(int argc, char** argv);
+#if PLATFORM_WIN32
+	bool CreateAppWindow(const std::string& windowName);
+#endif
+	void UpdateHeadless(void);	// runs the set number of frames as fast as possible with a fixed delta time
+	void UpdateFrame(float frameTime);	// input, messages and systems of one frame
+	void RecordHitch(void);	// adds the slowest system to the frame counter when the last frame was a hitch
+	void Simulate(float deltaTime);	// runs the simulation ticks the frame's time covers
 	void CreateSystems(void);
 	void RegisterMessages(void) const;	// register messages for systems
 	void RegisterComponents(void) const; // register components for systems
 	bool InitializeSystems(void);
-	void UpdateSystems(float deltaTime);
+	void UpdateSystemsUI(float deltaTime);
+	void UpdateSystems(float deltaTime, bool simulation);	// updates simulation or per frame systems
 	void ExitSystems(void);
+	void ShowDebugOverlay(void);	// engine statistics windows, debug builds only
+	void ShowSystemSchedule(void) const;
+
+	/* System scheduling */
+	struct ScheduledSystem
+	{
+		ISystem* m_system = nullptr;
+		SystemAccess m_access;
+		uint32_t m_wave = 0U;	// systems in the same wave have no conflicting access
+		float m_updateTime = 0.0f;	// milliseconds spent in Update during the last frame, all ticks together
+		Messenger::Outbox m_outbox;	// messages sent during Update, merged in schedule order after the wave
+	};
+
+	void BuildSchedule(void);	// places every system in the first wave after all earlier systems it conflicts with, when access changed
+	void UpdateScheduledSystem(ScheduledSystem& entry, float deltaTime);
 
 	template <typename SystemType>
 	void CreateSystem(void);	// creates a system of SystemType
 
 private:
+	Profiler m_profiler;	// declared first so it outlives the job system threads that record into it
 	std::vector<ISystem*> m_systems;
+	std::vector<ScheduledSystem> m_schedule;	// same order as m_systems
+	uint32_t m_numWaves;
 	INIReader* m_ini;
 
 	Messenger m_messenger;
+	MessageJournal m_journal;
+	JobSystem m_jobSystem;
+#if PLATFORM_WIN32
 	Window m_window;
+#endif
 	Input m_input;
 	std::string m_assetPath; // stores path to assets
 
@@ -76,21 +130,36 @@ private:
 	WorldManager* m_worldManager;
 
 	bool m_running;
+	bool m_exitAfterPlayback;	// set when an input recording is played back
+
+	/* Headless run: always on without a Win32 window, 0 frames run until the app exits */
+	bool m_headless;
+	uint32_t m_headlessFrames;
+	float m_headlessDeltaTime;	// seconds, used unless input playback supplies recorded ones
+
+	/* Fixed simulation tick */
+	float m_simulationStep;	// seconds, 0 runs one tick with the frame's delta time
+	uint32_t m_maxSimulationSteps;	// per frame, time left over after them is dropped
+	float m_accumulator;	// frame time not simulated yet
+	uint64_t m_simulationTick;
+	float m_interpolationAlpha;
 
 	Vector2 m_windowSize;
 
+#if PLATFORM_WIN32
 	/* Window class data */
 	HINSTANCE m_hInstance;
+#endif
 
 	/* Frame time counter */
 	FrameCounter m_frameCounter;
 };
 
 template<typename ClientGameplaySystemType>
-bool App::Initialize(void)
+bool App::Initialize(int argc, char** argv)
 {
 	CreateSystem<ClientGameplaySystemType>();
-	return InitializeApp();
+	return InitializeApp(argc, argv);
 }
 
 template <typename SystemType>
@@ -0,0 +1,100 @@
+// Copyright (C) 2023  Mantas Naujokas
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "BinaryStream.h"
+#include <string.h>
+
+BinaryWriter::BinaryWriter(std::vector<uint8_t>& buffer)
+	: m_buffer(buffer)
+{}
+
+void BinaryWriter::WriteString(const std::string& value)
+{
+	uint32_t length = static_cast<uint32_t>(value.size());
+	Write(length);
+	WriteBytes(value.data(), value.size());
+}
+
+void BinaryWriter::WriteBytes(const void* data, size_t size)
+{
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+}
+
+size_t BinaryWriter::GetSize(void) const
+{
+	return m_buffer.size();
+}
+
+BinaryReader::BinaryReader(const uint8_t* data, size_t size)
+	: m_data(data)
+	, m_size(size)
+	, m_offset(0U)
+	, m_isValid(true)
+{}
+
+bool BinaryReader::ReadString(std::string& value)
+{
+	uint32_t length = 0U;
+	if (!Read(length) || m_size - m_offset < length)
+	{
+		m_isValid = false;
+		return false;
+	}
+
+	value.assign(reinterpret_cast<const char*>(m_data + m_offset), length);
+	m_offset += length;
+	return true;
+}
+
+bool BinaryReader::ReadBytes(void* data, size_t size)
+{
+	if (m_size - m_offset < size)
+	{
+		m_isValid = false;
+		return false;
+	}
+
+	memcpy(data, m_data + m_offset, size);
+	m_offset += size;
+	return true;
+}
+
+bool BinaryReader::Skip(size_t size)
+{
+	if (m_size - m_offset < size)
+	{
+		m_isValid = false;
+		return false;
+	}
+
+	m_offset += size;
+	return true;
+}
+
+bool BinaryReader::IsValid(void) const
+{
+	return m_isValid;
+}
+
+bool BinaryReader::IsAtEnd(void) const
+{
+	return m_offset == m_size;
+}
+
+size_t BinaryReader::GetOffset(void) const
+{
+	return m_offset;
+}
@@ -0,0 +1,79 @@
+// Copyright (C) 2023  Mantas Naujokas
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef BINARYSTREAM_H
+#define BINARYSTREAM_H
+
+#include <stdint.h>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/* BinaryWriter - appends plain data to a byte buffer */
+class BinaryWriter
+{
+public:
+	BinaryWriter(std::vector<uint8_t>& buffer);
+
+	template <typename Type>
+	void Write(const Type& value);
+	void WriteString(const std::string& value);
+	void WriteBytes(const void* data, size_t size);
+
+	size_t GetSize(void) const;
+
+private:
+	std::vector<uint8_t>& m_buffer;
+};
+
+/* BinaryReader - reads plain data from a byte buffer. Reading past the end fails,
+leaves the value untouched and marks the reader invalid */
+class BinaryReader
+{
+public:
+	BinaryReader(const uint8_t* data, size_t size);
+
+	template <typename Type>
+	bool Read(Type& value);
+	bool ReadString(std::string& value);
+	bool ReadBytes(void* data, size_t size);
+	bool Skip(size_t size);
+
+	bool IsValid(void) const;	// false if any read failed
+	bool IsAtEnd(void) const;
+	size_t GetOffset(void) const;	// bytes read so far
+
+private:
+	const uint8_t* m_data;
+	size_t m_size;
+	size_t m_offset;
+	bool m_isValid;
+};
+
+template <typename Type>
+void BinaryWriter::Write(const Type& value)
+{
+	static_assert(std::is_trivially_copyable<Type>::value, "BinaryWriter::Write: type has to be trivially copyable");
+	WriteBytes(&value, sizeof(Type));
+}
+
+template <typename Type>
+bool BinaryReader::Read(Type& value)
+{
+	static_assert(std::is_trivially_copyable<Type>::value, "BinaryReader::Read: type has to be trivially copyable");
+	return ReadBytes(&value, sizeof(Type));
+}
+
+#endif
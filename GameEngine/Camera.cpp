@@ -21,6 +21,7 @@
 #include "Messenger.h"
 #include "MessagesInput.h"
 #include "World.h"
+#include <math.h>
 
 void Camera::Register(void)
 {
@@ -345,7 +345,7 @@ namespace
 		float y = y1 + y2;
 
 
-		Vector2 retVec({ vec.x * cos(rad) + vec.y * sin(rad), vec.x * -sin(rad) + vec.y * cos(rad) });
+		Vector2 retVec(x, y);
 
 		return retVec;
 	}
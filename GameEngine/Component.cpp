@@ -18,21 +18,33 @@
 
 Component::Component(uint64_t id, GameObject* owner)
 	: Subscriber(GameObjectFactory::Get()->GetMessenger())
+	, m_owner(owner)
 	, m_id(id)
 	, m_isInitialized(false)
-	, m_owner(owner)
+	, m_isDormant(false)
 {}
 
 Component::Component(const Component& rhs)
 	: Subscriber(rhs.m_messenger)
+	, m_owner(rhs.m_owner)
 	, m_id(GameObjectFactory::Get()->GenerateID())
 	, m_isInitialized(rhs.m_isInitialized)
-	, m_owner(rhs.m_owner)
+	, m_isDormant(rhs.m_isDormant)
 {}
 
 Component::~Component(void)
 {}
 
+void* Component::operator new(size_t size)
+{
+	return GameObjectFactory::Get()->AllocateStorage(size);
+}
+
+void Component::operator delete(void* storage)
+{
+	GameObjectFactory::Get()->ReleaseStorage(storage);
+}
+
 bool Component::IsInitialized(void) const
 {
 	return m_isInitialized;
@@ -52,3 +64,26 @@ void Component::SetOwner(GameObject* owner)
 {
 	m_owner = owner;
 }
+
+void Component::SetDormant(bool dormant)
+{
+	if (m_isDormant != dormant)
+	{
+		m_isDormant = dormant;
+		GameObjectFactory::Get()->NotifyObjectListChanged();
+	}
+}
+
+bool Component::IsDormant(void) const
+{
+	return m_isDormant || (m_owner != nullptr && m_owner->IsDormant());
+}
+
+void Component::Wake(void)
+{
+	SetDormant(false);
+	if (m_owner != nullptr)
+	{
+		m_owner->SetDormant(false);
+	}
+}
@@ -19,6 +19,8 @@
 #include <string>
 #include "FileSystem.h"
 
+class BinaryReader;
+class BinaryWriter;
 class JSONData;
 class GameObject;
 
@@ -35,12 +37,24 @@ public:
 	GameObject* GetOwner(void) const;
 	void SetOwner(GameObject* owner);
 
+	// Dormant components are skipped by systems, a component is dormant when it or its owner is
+	void SetDormant(bool dormant);
+	bool IsDormant(void) const;
+	void Wake(void);	// wakes the component and its owner
+
+	// Component storage is taken from and returned to GameObjectFactory
+	static void* operator new(size_t size);
+	static void operator delete(void* storage);
+
 protected:
 	Component(uint64_t id, GameObject* owner);
 	Component(const Component& rhs);
 	virtual ~Component(void);
 
 	virtual void Deserialize(const JSONData& source) = 0;
+	// Write/ReadBinary: component's deserialized fields in compiled prefab form
+	virtual void WriteBinary(BinaryWriter& writer) const {}
+	virtual void ReadBinary(BinaryReader& reader) {}
 
 	virtual Component* Clone(void) const = 0;
 
@@ -52,6 +66,7 @@ protected:
 private:
 	uint64_t m_id;
 	bool m_isInitialized;
+	bool m_isDormant;
 };
 
 #endif
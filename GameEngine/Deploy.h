@@ -16,14 +16,18 @@
 #ifndef DEPLOY_H
 #define DEPLOY_H
 
-#ifdef _DEBUG
+#include "Platform.h"
+
+#if defined(_DEBUG) || !PLATFORM_WIN32
 #define MAIN_RET int
 #define MAIN_NAME main
-#define MAIN_PARAMS void
+#define MAIN_PARAMS int argc, char** argv
+#define MAIN_ARGS argc, argv
 #else
 #define MAIN_RET INT
 #define MAIN_NAME WINAPI WinMain
 #define MAIN_PARAMS _In_ HINSTANCE, _In_opt_ HINSTANCE, _In_ LPSTR, _In_ int
+#define MAIN_ARGS __argc, __argv	// command line parsed by the C runtime
 #endif
 
 // Create app with GamePlaySystemType
@@ -32,7 +36,7 @@ MAIN_RET MAIN_NAME(MAIN_PARAMS) \
 { \
 	App app; \
 \
-	bool initialized = app.Initialize<GameplaySystemType>(); \
+	bool initialized = app.Initialize<GameplaySystemType>(MAIN_ARGS); \
 	if (!initialized) \
 	{ \
 		app.Exit(); \
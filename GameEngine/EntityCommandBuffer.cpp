@@ -0,0 +1,112 @@
+// Copyright (C) 2023  Mantas Naujokas
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "EntityCommandBuffer.h"
+#include "GameObject.h"
+#include "JobSystem.h"
+#include <algorithm>
+
+EntityCommandBuffer::EntityCommandBuffer(void)
+	: m_sequence(0U)
+{}
+
+void EntityCommandBuffer::CreateObject(const std::string& type, World* world, const std::function<void(GameObject*)>& onCreated)
+{
+	Command command = { CommandType::Create, 0U, world, nullptr, 0U, type, onCreated, nullptr };
+	Record(command);
+}
+
+void EntityCommandBuffer::AddComponent(GameObject* object, const std::string& componentType, const std::function<void(Component*)>& onAdded)
+{
+	Command command = { CommandType::AddComponent, 0U, nullptr, object, object->GetID(), componentType, nullptr, onAdded };
+	Record(command);
+}
+
+void EntityCommandBuffer::DestroyObject(GameObject* object)
+{
+	Command command = { CommandType::Destroy, 0U, nullptr, object, object->GetID(), "", nullptr, nullptr };
+	Record(command);
+}
+
+void EntityCommandBuffer::TakeCommands(std::vector<Command>& commands)
+{
+	commands.clear();
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		commands.swap(m_commands);
+	}
+
+	/* Creates are grouped by world and type so they can be created in batches,
+	other commands by target. Recording order is kept within a group */
+	std::sort(commands.begin(), commands.end(), [](const Command& lhs, const Command& rhs)
+	{
+		if (lhs.m_type != rhs.m_type)
+		{
+			return lhs.m_type < rhs.m_type;
+		}
+		if (lhs.m_type == CommandType::Create)
+		{
+			if (lhs.m_world != rhs.m_world)
+			{
+				return std::less<World*>()(lhs.m_world, rhs.m_world);
+			}
+			if (lhs.m_typeName != rhs.m_typeName)
+			{
+				return lhs.m_typeName < rhs.m_typeName;
+			}
+		}
+		else if (lhs.m_target != rhs.m_target)
+		{
+			return std::less<GameObject*>()(lhs.m_target, rhs.m_target);
+		}
+		return lhs.m_sequence < rhs.m_sequence;
+	});
+}
+
+bool EntityCommandBuffer::IsEmpty(void) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_commands.empty();
+}
+
+EntityCommandBuffer::ThreadBuffer* EntityCommandBuffer::BindThreadBuffer(ThreadBuffer* buffer)
+{
+	return static_cast<ThreadBuffer*>(JobSystem::SetJobLocal(JobSystem::JobLocal::CommandBuffer, buffer));
+}
+
+void EntityCommandBuffer::MergeThreadBuffer(ThreadBuffer& buffer)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (Command& command : buffer)
+	{
+		command.m_sequence = m_sequence++;
+		m_commands.push_back(std::move(command));
+	}
+	buffer.clear();
+}
+
+void EntityCommandBuffer::Record(Command& command)
+{
+	ThreadBuffer* boundBuffer = static_cast<ThreadBuffer*>(JobSystem::GetJobLocal(JobSystem::JobLocal::CommandBuffer));
+	if (boundBuffer != nullptr)
+	{ // sequence is given when the buffer is merged
+		boundBuffer->push_back(std::move(command));
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	command.m_sequence = m_sequence++;
+	m_commands.push_back(std::move(command));
+}
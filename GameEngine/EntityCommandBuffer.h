@@ -0,0 +1,108 @@
+// Copyright (C) 2023  Mantas Naujokas
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef ENTITYCOMMANDBUFFER_H
+#define ENTITYCOMMANDBUFFER_H
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class Component;
+class GameObject;
+class World;
+
+/* EntityCommandBuffer - records structural changes (create, add component, destroy) from any thread.
+GameObjectFactory applies them at a sync point, when no system is iterating objects */
+class EntityCommandBuffer
+{
+public:
+	// CommandType: commands are applied in this order
+	enum class CommandType
+	{
+		Create,
+		AddComponent,
+		Destroy
+	};
+
+	struct Command
+	{
+		CommandType m_type;
+		uint64_t m_sequence;	// recording order
+		World* m_world;	// world to create object in
+		GameObject* m_target;	// object to add component to or destroy
+		uint64_t m_targetID;	// target is skipped if it was destroyed before the commands were applied
+		std::string m_typeName;	// object or component type
+		std::function<void(GameObject*)> m_onCreated;
+		std::function<void(Component*)> m_onAdded;
+	};
+
+	EntityCommandBuffer(void);
+	EntityCommandBuffer(const EntityCommandBuffer& rhs) = delete;
+
+	// Callbacks are called on the main thread when the command is applied
+	void CreateObject(const std::string& type, World* world, const std::function<void(GameObject*)>& onCreated = nullptr);
+	template <typename Type>
+	void CreateObject(World* world, const std::function<void(Type*)>& onCreated = nullptr);
+
+	void AddComponent(GameObject* object, const std::string& componentType, const std::function<void(Component*)>& onAdded = nullptr);
+	template <typename CompType>
+	void AddComponent(GameObject* object, const std::function<void(CompType*)>& onAdded = nullptr);
+
+	void DestroyObject(GameObject* object);
+
+	// TakeCommands: moves recorded commands to commands, sorted in the order they are applied in
+	void TakeCommands(std::vector<Command>& commands);
+	bool IsEmpty(void) const;
+
+	/* ThreadBuffer - while a buffer is bound to a thread, commands recorded on it are kept there. Bindings are
+	job locals like Messenger outboxes. MergeThreadBuffer records them, merging buffers in a fixed order keeps command order deterministic */
+	typedef std::vector<Command> ThreadBuffer;
+	static ThreadBuffer* BindThreadBuffer(ThreadBuffer* buffer);	// nullptr unbinds, returns the previous binding to restore
+	void MergeThreadBuffer(ThreadBuffer& buffer);
+
+private:
+	void Record(Command& command);
+
+private:
+	mutable std::mutex m_mutex;
+	std::vector<Command> m_commands;
+	uint64_t m_sequence;
+};
+
+template <typename Type>
+void EntityCommandBuffer::CreateObject(World* world, const std::function<void(Type*)>& onCreated)
+{
+	std::function<void(GameObject*)> typedCallback = nullptr;
+	if (onCreated)
+	{
+		typedCallback = [onCreated](GameObject* object) { onCreated(static_cast<Type*>(object)); };
+	}
+	CreateObject(Type::GetClassTypeName(), world, typedCallback);
+}
+
+template <typename CompType>
+void EntityCommandBuffer::AddComponent(GameObject* object, const std::function<void(CompType*)>& onAdded)
+{
+	std::function<void(Component*)> typedCallback = nullptr;
+	if (onAdded)
+	{
+		typedCallback = [onAdded](Component* component) { onAdded(static_cast<CompType*>(component)); };
+	}
+	AddComponent(object, CompType::GetClassTypeName(), typedCallback);
+}
+
+#endif
@@ -39,11 +39,27 @@ bool FileSystem::Initialize(INIReader* ini)
 	return true;
 }
 
+const char* FileSystem::GetName(void) const
+{
+	return "FileSystem";
+}
+
 void FileSystem::Update(float deltaTime)
 {
 	FulfillFileRequests();
 }
 
+void FileSystem::DeclareAccess(SystemAccess& access) const
+{
+	/* Request callbacks belong to other systems and can touch anything, only an idle frame is known to be safe */
+	access.m_writesAll = !m_fileRequests.empty();
+	access.m_mainThread = true;
+	if (access.m_writes.empty())
+	{
+		access.m_writes = { "FileRequests" };
+	}
+}
+
 void FileSystem::Exit(void)
 {
 	m_objects.clear();
@@ -79,26 +95,21 @@ void FileSystem::GetFiles(const char* type, std::vector<const DirectoryObject*>&
 
 void FileSystem::RegisterMessages(void)
 {
-	m_messenger.RegisterMessage<FileRequestMessage>(this);
+	m_messenger.Subscribe<FileRequestMessage>(this, &FileSystem::OnFileRequest);
 }
 
-void FileSystem::ProcessMessage(const Message* message)
+void FileSystem::OnFileRequest(const FileRequestMessage& msg)
 {
-	if (message->IsType<FileRequestMessage>())
+	auto extensionIter = m_fileRequests.find(msg.m_extension);
+	if (extensionIter != m_fileRequests.end())
 	{
-		const FileRequestMessage* msg = static_cast<const FileRequestMessage*>(message);
-
-		auto extensionIter = m_fileRequests.find(msg->m_extension);
-		if (extensionIter != m_fileRequests.end())
-		{
-			extensionIter->second.push_back(msg->m_FileLoader);
-		}
-		else
-		{
-			std::vector<std::function<void(const std::string&)>> loaders;
-			loaders.push_back(msg->m_FileLoader);
-			m_fileRequests.insert({ msg->m_extension, loaders });
-		}
+		extensionIter->second.push_back(msg.m_FileLoader);
+	}
+	else
+	{
+		std::vector<std::function<void(const std::string&)>> loaders;
+		loaders.push_back(msg.m_FileLoader);
+		m_fileRequests.insert({ msg.m_extension, loaders });
 	}
 }
 
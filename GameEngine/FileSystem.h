@@ -24,6 +24,8 @@
 
 namespace fs = std::filesystem;
 
+class FileRequestMessage;
+
 class DirectoryObject
 {
 public:
@@ -43,16 +45,18 @@ public:
 	bool Initialize(INIReader* ini) override final;
 	void Update(float deltaTime) override final;
 	void Exit(void) override final;
+	const char* GetName(void) const override final;
 	
 	/* Get a list of files of a particular type: e.g. ".txt", ".json" */
 	void GetFiles(const char* type, std::vector<const DirectoryObject*>& list) const;
 
 	void RegisterMessages(void);
-	void ProcessMessage(const Message* message) override final;
+	void DeclareAccess(SystemAccess& access) const override final;
 
 	static std::string NormalizePath(const std::string& path); // normalizes path to use universal Unix style
 
 private:
+	void OnFileRequest(const FileRequestMessage& msg);
 	void FulfillFileRequests(void); // checks for any pending file requests and fulfills them
 
 	void ScanFolder(const std::string& path);
@@ -15,6 +15,51 @@
 
 #include "FrameCounter.h"
 #include "MathConstants.h"
+#include "Platform.h"
+#include <imgui.h>
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <thread>
+
+#if PLATFORM_WIN32
+#include <Windows.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002	// Windows 10 1803 and newer, older SDKs lack the define
+#endif
+#endif
+
+static const size_t MAX_HITCHES = 1000U;
+static const float MIN_SPIN_MARGIN = 0.05f;	// milliseconds
+static const float OVERSLEEP_SMOOTHING = 0.1f;	// weight of the newest sleep in the oversleep estimate
+
+// Percentile: nearest rank of an ascending list
+static float Percentile(const std::vector<float>& sorted, float percentile)
+{
+	size_t rank = static_cast<size_t>(ceilf(percentile * 0.01f * static_cast<float>(sorted.size())));
+	return sorted[rank > 0U ? rank - 1U : 0U];
+}
+
+FrameCounter::FrameCounter(void)
+{
+#if PLATFORM_WIN32
+	m_timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+	if (m_timer == nullptr)
+	{
+		fprintf(stderr, "FrameCounter::%s: high resolution timer not available, sleeps use the system timer\n", __func__);
+	}
+#endif
+}
+
+FrameCounter::~FrameCounter(void)
+{
+#if PLATFORM_WIN32
+	if (m_timer != nullptr)
+	{
+		CloseHandle(m_timer);
+	}
+#endif
+}
 
 void FrameCounter::Start(void)
 {
@@ -24,10 +69,18 @@ void FrameCounter::Start(void)
 void FrameCounter::Finish(void)
 {
 	m_lastDelta = std::chrono::steady_clock::now() - m_frameStart;
-	while (m_lastDelta < m_lockedFrameTime)
+	if (m_lastDelta < m_lockedFrameTime)
 	{
-		m_lastDelta = std::chrono::steady_clock::now() - m_frameStart;
+		WaitForFrameTime();
+
+		m_lastPacingError = std::chrono::duration<float, std::milli>(m_lastDelta - m_lockedFrameTime).count();
+		m_totalPacingError += m_lastPacingError;
+		m_maxPacingError = std::max(m_maxPacingError, m_lastPacingError);
+		++m_numPacedFrames;
 	}
+
+	m_history[m_numFrames % m_history.size()] = std::chrono::duration<float, std::milli>(m_lastDelta).count();
+	++m_numFrames;
 }
 
 float FrameCounter::GetDelta(void) const
@@ -40,4 +93,216 @@ void FrameCounter::SetFPSLock(uint32_t fps)
 	float timeNanoFL = fps > 0 ? NANO / static_cast<float>(fps) : 0.0f;
 	uint64_t timeNanoUINT = static_cast<uint64_t>(timeNanoFL);
 	m_lockedFrameTime = std::chrono::nanoseconds(timeNanoUINT);
-}
\ No newline at end of file
+}
+
+float FrameCounter::GetPacingError(void) const
+{
+	return m_lastPacingError;
+}
+
+float FrameCounter::GetMeanPacingError(void) const
+{
+	return m_numPacedFrames > 0U ? static_cast<float>(m_totalPacingError / m_numPacedFrames) : 0.0f;
+}
+
+void FrameCounter::WaitForFrameTime(void)
+{
+	/* Sleep while more than the spin margin is left, every sleep refines the margin */
+	std::chrono::duration<float, std::milli> spinMargin(m_spinMargin);
+	std::chrono::nanoseconds remaining = m_lockedFrameTime - m_lastDelta;
+	while (remaining > spinMargin)
+	{
+		std::chrono::nanoseconds request = remaining - std::chrono::duration_cast<std::chrono::nanoseconds>(spinMargin);
+		std::chrono::steady_clock::time_point sleepStart = std::chrono::steady_clock::now();
+		SleepFor(request);
+		std::chrono::duration<float, std::milli> slept = std::chrono::steady_clock::now() - sleepStart;
+
+		UpdateSpinMargin(slept.count() - std::chrono::duration<float, std::milli>(request).count());
+		spinMargin = std::chrono::duration<float, std::milli>(m_spinMargin);
+
+		m_lastDelta = std::chrono::steady_clock::now() - m_frameStart;
+		remaining = m_lockedFrameTime - m_lastDelta;
+	}
+
+	while (m_lastDelta < m_lockedFrameTime)
+	{
+		m_lastDelta = std::chrono::steady_clock::now() - m_frameStart;
+	}
+}
+
+void FrameCounter::SleepFor(std::chrono::nanoseconds duration)
+{
+#if PLATFORM_WIN32
+	if (m_timer != nullptr)
+	{
+		LARGE_INTEGER dueTime;
+		dueTime.QuadPart = -static_cast<LONGLONG>(duration.count() / 100);	// relative, 100 ns units
+		if (SetWaitableTimerEx(m_timer, &dueTime, 0, nullptr, nullptr, nullptr, 0) != FALSE)
+		{
+			WaitForSingleObject(m_timer, INFINITE);
+			return;
+		}
+	}
+#endif
+	std::this_thread::sleep_for(duration);
+}
+
+void FrameCounter::UpdateSpinMargin(float oversleep)
+{
+	/* Margin covers the expected oversleep plus two standard deviations, it cannot exceed the frame time */
+	float deviation = oversleep - m_oversleepMean;
+	m_oversleepMean += OVERSLEEP_SMOOTHING * deviation;
+	m_oversleepVariance = (1.0f - OVERSLEEP_SMOOTHING) * (m_oversleepVariance + OVERSLEEP_SMOOTHING * deviation * deviation);
+
+	float lockedFrameTime = std::chrono::duration<float, std::milli>(m_lockedFrameTime).count();
+	m_spinMargin = std::min(std::max(m_oversleepMean + 2.0f * sqrtf(m_oversleepVariance), MIN_SPIN_MARGIN), lockedFrameTime);
+}
+
+void FrameCounter::SetHistorySize(uint32_t numFrames)
+{
+	m_history.assign(numFrames > 0U ? numFrames : 1U, 0.0f);
+	m_numFrames = 0U;
+}
+
+void FrameCounter::SetHitchThreshold(float milliseconds)
+{
+	m_hitchThreshold = milliseconds;
+}
+
+bool FrameCounter::IsHitch(void) const
+{
+	if (m_hitchThreshold <= 0.0f || m_numFrames == 0U)
+	{
+		return false;
+	}
+
+	return m_history[(m_numFrames - 1U) % m_history.size()] > m_hitchThreshold;
+}
+
+void FrameCounter::AddHitch(const std::string& slowestSystem, float systemTime)
+{
+	if (m_numFrames == 0U)
+	{
+		return;
+	}
+
+	if (m_hitches.size() >= MAX_HITCHES)
+	{
+		m_hitches.erase(m_hitches.begin());
+	}
+
+	Hitch hitch;
+	hitch.m_frame = m_numFrames - 1U;
+	hitch.m_frameTime = m_history[hitch.m_frame % m_history.size()];
+	hitch.m_slowestSystem = slowestSystem;
+	hitch.m_systemTime = systemTime;
+	m_hitches.push_back(hitch);
+}
+
+FrameStats FrameCounter::GetStats(void) const
+{
+	FrameStats stats;
+	size_t numFrames = static_cast<size_t>(std::min<uint64_t>(m_numFrames, m_history.size()));
+	if (numFrames == 0U)
+	{
+		return stats;
+	}
+
+	std::vector<float> sorted(m_history.begin(), m_history.begin() + numFrames);
+	std::sort(sorted.begin(), sorted.end());
+
+	double total = 0.0;
+	for (float frameTime : sorted)
+	{
+		total += frameTime;
+	}
+
+	stats.m_numFrames = static_cast<uint32_t>(numFrames);
+	stats.m_min = sorted.front();
+	stats.m_mean = static_cast<float>(total / numFrames);
+	stats.m_p50 = Percentile(sorted, 50.0f);
+	stats.m_p95 = Percentile(sorted, 95.0f);
+	stats.m_p99 = Percentile(sorted, 99.0f);
+	stats.m_max = sorted.back();
+	return stats;
+}
+
+const std::vector<Hitch>& FrameCounter::GetHitches(void) const
+{
+	return m_hitches;
+}
+
+void FrameCounter::ShowStatistics(void) const
+{
+	FrameStats stats = GetStats();
+
+	ImGui::Begin("Frame Time");
+	ImGui::Text("Last %u frames (ms)", stats.m_numFrames);
+	ImGui::Text("Min %.2f  Mean %.2f  Max %.2f", stats.m_min, stats.m_mean, stats.m_max);
+	ImGui::Text("P50 %.2f  P95 %.2f  P99 %.2f", stats.m_p50, stats.m_p95, stats.m_p99);
+	ImGui::Text("Pacing error %.3f (mean %.3f, max %.3f), spin margin %.3f", m_lastPacingError, GetMeanPacingError(),
+		m_maxPacingError, m_spinMargin);
+
+	/* Oldest frame is at the next write slot once the history is full */
+	int offset = m_numFrames >= m_history.size() ? static_cast<int>(m_numFrames % m_history.size()) : 0;
+	ImGui::PlotLines("##FrameTimes", m_history.data(), static_cast<int>(stats.m_numFrames), offset,
+		nullptr, 0.0f, stats.m_max, ImVec2(0.0f, 60.0f));
+
+	ImGui::Text("Hitches over %.1f ms: %zu", m_hitchThreshold, m_hitches.size());
+	if (ImGui::BeginTable("Hitches", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY, ImVec2(0.0f, 150.0f)))
+	{
+		ImGui::TableSetupColumn("Frame");
+		ImGui::TableSetupColumn("Time (ms)");
+		ImGui::TableSetupColumn("Slowest system");
+		ImGui::TableSetupColumn("System (ms)");
+		ImGui::TableHeadersRow();
+
+		for (std::vector<Hitch>::const_reverse_iterator it = m_hitches.rbegin(); it != m_hitches.rend(); ++it)
+		{
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::Text("%llu", static_cast<unsigned long long>(it->m_frame));
+			ImGui::TableNextColumn();
+			ImGui::Text("%.2f", it->m_frameTime);
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(it->m_slowestSystem.c_str());
+			ImGui::TableNextColumn();
+			ImGui::Text("%.2f", it->m_systemTime);
+		}
+
+		ImGui::EndTable();
+	}
+
+	ImGui::End();
+}
+
+bool FrameCounter::WriteStatisticsCSV(const std::string& path) const
+{
+	FILE* fp = fopen(path.c_str(), "w");
+	if (fp == nullptr)
+	{
+		fprintf(stderr, "FrameCounter::%s: failed to open \"%s\"\n", __func__, path.c_str());
+		return false;
+	}
+
+	/* Statistics of the history first, then one row per hitch */
+	FrameStats stats = GetStats();
+	fprintf(fp, "Statistic,FrameTimeMs,Frame,SlowestSystem,SystemTimeMs\n");
+	fprintf(fp, "\"Frames\",%u,,,\n", stats.m_numFrames);
+	fprintf(fp, "\"Min\",%.3f,,,\n", stats.m_min);
+	fprintf(fp, "\"Mean\",%.3f,,,\n", stats.m_mean);
+	fprintf(fp, "\"P50\",%.3f,,,\n", stats.m_p50);
+	fprintf(fp, "\"P95\",%.3f,,,\n", stats.m_p95);
+	fprintf(fp, "\"P99\",%.3f,,,\n", stats.m_p99);
+	fprintf(fp, "\"Max\",%.3f,,,\n", stats.m_max);
+	fprintf(fp, "\"Mean pacing error\",%.3f,,,\n", GetMeanPacingError());
+	fprintf(fp, "\"Max pacing error\",%.3f,,,\n", m_maxPacingError);
+	for (const Hitch& hitch : m_hitches)
+	{
+		fprintf(fp, "\"Hitch\",%.3f,%llu,\"%s\",%.3f\n", hitch.m_frameTime, static_cast<unsigned long long>(hitch.m_frame),
+			hitch.m_slowestSystem.c_str(), hitch.m_systemTime);
+	}
+
+	fclose(fp);
+	return true;
+}
@@ -18,12 +18,41 @@
 
 #include <stdint.h>
 #include <chrono>
+#include <string>
+#include <vector>
+
+/* FrameStats - frame times in milliseconds over the frames in history */
+struct FrameStats
+{
+	uint32_t m_numFrames = 0U;
+	float m_min = 0.0f;
+	float m_mean = 0.0f;
+	float m_p50 = 0.0f;
+	float m_p95 = 0.0f;
+	float m_p99 = 0.0f;
+	float m_max = 0.0f;
+};
+
+/* Hitch - frame that took longer than the hitch threshold */
+struct Hitch
+{
+	uint64_t m_frame = 0U;
+	float m_frameTime = 0.0f;	// milliseconds
+	std::string m_slowestSystem;
+	float m_systemTime = 0.0f;	// milliseconds the slowest system spent in Update
+};
 
 class FrameCounter
 {
 public:
+	FrameCounter(void);
+	~FrameCounter(void);
+	FrameCounter(const FrameCounter& rhs) = delete;
+
 	void Start(void);	// start measurement
-	void Finish(void);	// finish measurement, wait for FPSLock time if necessary, record m_lastDelta
+	// Finish: finish measurement, wait for FPSLock time if necessary, record m_lastDelta.
+	// Waiting sleeps until the spin margin is left, then spins to the frame time
+	void Finish(void);
 	
 	/* Get last calculated delta time in seconds */
 	float GetDelta(void) const;
@@ -31,6 +60,21 @@ public:
 	/* SetFPSLock - lock FPS to a specified number of frames */
 	void SetFPSLock(uint32_t fps);
 
+	/* Frame time statistics */
+	void SetHistorySize(uint32_t numFrames);	// frames the statistics are calculated over
+	void SetHitchThreshold(float milliseconds);	// 0 disables hitch detection
+	bool IsHitch(void) const;	// last finished frame took longer than the hitch threshold
+	void AddHitch(const std::string& slowestSystem, float systemTime);	// records the last finished frame as a hitch
+	FrameStats GetStats(void) const;
+	const std::vector<Hitch>& GetHitches(void) const;
+
+	/* Frame pacing: error is how much later than the locked frame time a frame finished, in milliseconds */
+	float GetPacingError(void) const;	// last paced frame
+	float GetMeanPacingError(void) const;
+
+	void ShowStatistics(void) const;
+	bool WriteStatisticsCSV(const std::string& path) const;
+
 private:
 	/* Frame time in seconds, determined by value sent to SetFPSLock */
 	std::chrono::nanoseconds m_lockedFrameTime = {};
@@ -40,6 +84,26 @@ private:
 
 	/* Delta time of the last frame */
 	std::chrono::nanoseconds m_lastDelta = {};
+
+	void WaitForFrameTime(void);
+	void SleepFor(std::chrono::nanoseconds duration);
+	void UpdateSpinMargin(float oversleep);	// oversleep in milliseconds
+
+	/* Pacing: sleeps overshoot by a varying amount, the last m_spinMargin before the frame time is spun */
+	void* m_timer = nullptr;	// Win32 high resolution waitable timer, sleep_for is used without it
+	float m_oversleepMean = 0.0f;	// milliseconds
+	float m_oversleepVariance = 0.0f;
+	float m_spinMargin = 1.0f;	// milliseconds
+	float m_lastPacingError = 0.0f;
+	double m_totalPacingError = 0.0;
+	float m_maxPacingError = 0.0f;
+	uint64_t m_numPacedFrames = 0U;
+
+	/* Rolling frame time history in milliseconds, m_numFrames % size is the next slot */
+	std::vector<float> m_history = std::vector<float>(1000U);
+	uint64_t m_numFrames = 0U;
+	float m_hitchThreshold = 0.0f;
+	std::vector<Hitch> m_hitches;	// oldest are dropped after MAX_HITCHES
 };
 
 #endif
@@ -15,27 +15,34 @@
 
 #include "GameObject.h"
 #include "GameObjectFactory.h"
+#include "World.h"
 
 GameObject::GameObject(uint64_t id, World* parentWorld)
 	: m_id(id)
 	, m_parentWorld(parentWorld)
 	, m_parent(nullptr)
+	, m_parallelUpdate(false)
+	, m_isDormant(false)
 {}
 
 GameObject::GameObject(const GameObject& rhs)
 	: m_id(GameObjectFactory::Get()->GenerateID())
 	, m_parentWorld(rhs.m_parentWorld)
 	, m_parent(rhs.m_parent)
+	, m_parallelUpdate(rhs.m_parallelUpdate)
+	, m_isDormant(rhs.m_isDormant)
 {
 	GameObjectFactory* GOF = GameObjectFactory::Get();
 	for (GameObject* rhsChild : rhs.m_children)
 	{
 		GameObject* childCopy = GOF->Clone(rhsChild);
+		childCopy->m_parent = this;
 		m_children.push_back(childCopy);
 	}
 	for (Component* rhsComp : rhs.m_components)
 	{
 		Component* copy = GameObjectFactory::Get()->Clone(rhsComp);
+		copy->SetOwner(this);
 		m_components.push_back(copy);
 	}
 }
@@ -68,6 +75,16 @@ GameObject::~GameObject(void)
 	}
 }
 
+void* GameObject::operator new(size_t size)
+{
+	return GameObjectFactory::Get()->AllocateStorage(size);
+}
+
+void GameObject::operator delete(void* storage)
+{
+	GameObjectFactory::Get()->ReleaseStorage(storage);
+}
+
 uint64_t GameObject::GetID(void) const
 {
 	return m_id;
@@ -110,5 +127,35 @@ void GameObject::AddComponent(Component* component)
 	m_components.push_back(component);
 }
 
+void GameObject::SetParallelUpdate(bool enabled)
+{
+	m_parallelUpdate = enabled;
+}
+
+bool GameObject::IsParallelUpdate(void) const
+{
+	return m_parallelUpdate;
+}
+
+void GameObject::SetDormant(bool dormant)
+{
+	if (m_isDormant == dormant)
+	{
+		return;
+	}
+
+	m_isDormant = dormant;
+	if (m_parentWorld != nullptr)
+	{
+		m_parentWorld->QueueDormancyChange(this);
+	}
+	GameObjectFactory::Get()->NotifyObjectListChanged();
+}
+
+bool GameObject::IsDormant(void) const
+{
+	return m_isDormant;
+}
+
 void GameObject::CollisionReact(void)
 {}
@@ -20,22 +20,38 @@
 #include <vector>
 #include "Component.h"
 
+class BinaryReader;
+class BinaryWriter;
 class JSONData;
 class World;
 
 class GameObject
 {
 public:
+	friend class GameObjectFactory;
+
 	GameObject(uint64_t id, World* parentWorld);
 	GameObject(const GameObject& rhs);
 	virtual ~GameObject(void);
 
+	// Object storage is taken from and returned to GameObjectFactory
+	static void* operator new(size_t size);
+	static void operator delete(void* storage);
+
 	virtual void Deserialize(const JSONData& source) = 0;
+	// Write/ReadBinary: object's deserialized fields in compiled prefab form
+	virtual void WriteBinary(BinaryWriter& writer) const {}
+	virtual void ReadBinary(BinaryReader& reader) {}
 	virtual GameObject* Clone(World* parentWorld) const = 0;
 
 	virtual void Initialize(void) {}
 	virtual void Update(float deltaTime) = 0;
 
+	// Types with an empty Update hide HAS_UPDATE with false, World then never updates them
+	static constexpr bool HAS_UPDATE = true;
+	// BatchUpdateFunction: updates count objects of one concrete type
+	typedef void (*BatchUpdateFunction)(GameObject* const* objects, size_t count, float deltaTime);
+
 	uint64_t GetID(void) const;
 	virtual const std::string& GetObjectTypeName(void) const = 0;
 	World* GetParentWorld(void);
@@ -51,6 +67,17 @@ public:
 
 	void AddComponent(Component* component);
 
+	// Parallel update: Update only touches the object and its own components, so World can
+	// update it on a worker thread. Sends and structural changes are buffered and applied in order
+	void SetParallelUpdate(bool enabled);
+	bool IsParallelUpdate(void) const;
+
+	// Dormant objects are not updated or moved by physics and are kept in cached render lists.
+	// Collisions with them still call CollisionReact. They wake on WakeObjectMessage, when moved
+	// through SceneComponent::GetTransform or with SetDormant(false)
+	void SetDormant(bool dormant);
+	bool IsDormant(void) const;
+
 	virtual void CollisionReact(void); // object's default reaction to collision
 
 public:
@@ -68,6 +95,8 @@ private:
 	const uint64_t m_id;
 	// Vector of object's components
 	std::vector<Component*> m_components;
+	bool m_parallelUpdate;
+	bool m_isDormant;
 };
 
 template <typename Type>
@@ -14,17 +14,28 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "GameObjectFactory.h"
+#include "BinaryStream.h"
 #include "JSONData.h"
+#include "MemoryArena.h"
+#include "MemoryPool.h"
 #include "Messenger.h"
 #include "MessageFileRequest.h"
+#include "MessagesGameObjectFactory.h"
+#include "Prefab.h"
 #include "StringUtility.h"
 #include "World.h"
+#include <algorithm>
+#include <imgui.h>
 
 GameObjectFactory::GameObjectFactory(Messenger& messenger)
 	: Subscriber(messenger)
 	, Singleton(this)
 	, m_IDCounter(1U)	// ID starts at 1. 0 Reserved for dummy objects.
+	, m_objectListVersion(0U)
+	, m_allocationArena(nullptr)
 {
+	static_assert(sizeof(StorageHeader) % MemoryPool::BLOCK_ALIGNMENT == 0U, "StorageHeader has to keep block alignment");
+
 	FileRequestMessage frm;
 	frm.m_extension = ".go";
 	frm.m_FileLoader = std::bind(&GameObjectFactory::ReadGameObjectData, this, std::placeholders::_1);
@@ -38,23 +49,73 @@ GameObjectFactory::~GameObjectFactory(void)
 		delete it.second;
 	}
 
+	for (std::pair<std::string, Prefab*> it : m_prefabs)
+	{
+		delete it.second;
+	}
+
 	for (GameObject* obj : m_createdObjects)
 	{
 		delete obj;
 	}
+	m_createdObjects.clear();
+	m_objectsByID.clear();
+
+	/* Prototypes live in the pools as well, release them before the pools */
+	for (std::pair<std::string, GameObject*> it : m_objectTypeRegister)
+	{
+		delete it.second;
+	}
+	m_objectTypeRegister.clear();
+
+	for (std::pair<std::string, Component*> it : m_componentTypeRegister)
+	{
+		delete it.second;
+	}
+	m_componentTypeRegister.clear();
+
+	for (std::pair<size_t, MemoryPool*> it : m_pools)
+	{
+		delete it.second;
+	}
+	m_pools.clear();
 }
 
 void GameObjectFactory::RegisterMessages(void)
-{}
+{
+	m_messenger.Subscribe<WakeObjectMessage>(this, &GameObjectFactory::OnWakeObject);
+}
 
-void GameObjectFactory::ProcessMessage(const Message* message)
-{}
+void GameObjectFactory::OnWakeObject(const WakeObjectMessage& msg)
+{
+	GameObject* object = FindObject(msg.m_objectID);
+	if (object != nullptr)
+	{
+		object->SetDormant(false);
+	}
+}
+
+void GameObjectFactory::AddCreatedObject(GameObject* object)
+{
+	m_createdObjects.push_back(object);
+	m_objectsByID[object->GetID()] = object;
+}
 
 const std::vector<GameObject*>& GameObjectFactory::GetObjectList(void) const
 {
 	return m_createdObjects;
 }
 
+GameObject* GameObjectFactory::FindObject(uint64_t id) const
+{
+	std::unordered_map<uint64_t, GameObject*>::const_iterator it = m_objectsByID.find(id);
+	if (it == m_objectsByID.end())
+	{
+		return nullptr;
+	}
+	return it->second;
+}
+
 GameObject* GameObjectFactory::CreateNewObject(const std::string& type, World* parentWorld)
 {
 	GameObject* newObject = CreateNewObject_Internal(type, parentWorld);
@@ -62,6 +123,76 @@ GameObject* GameObjectFactory::CreateNewObject(const std::string& type, World* p
 	return newObject;
 }
 
+void GameObjectFactory::CreateNewObjects(const std::string& type, size_t count, World* parentWorld, std::vector<GameObject*>& out,
+	const std::function<void(GameObject*, size_t)>& instanceOverride)
+{
+	if (count == 0U)
+	{
+		return;
+	}
+
+	/* First instance goes through full deserialization and serves as the archetype for the rest */
+	GameObject* archetype = CreateNewObject_Internal(type, parentWorld);
+	if (archetype == nullptr)
+	{
+		return;
+	}
+
+	size_t firstIndex = out.size();
+	out.reserve(firstIndex + count);
+	out.push_back(archetype);
+
+	const Prefab* prefab = FindPrefab(type);
+
+	if (prefab == nullptr)
+	{ // children are not copied, objects without a prefab are deserialized one by one
+		for (size_t i = 1U; i < count; ++i)
+		{
+			out.push_back(CreateNewObject_Internal(type, parentWorld));
+		}
+	}
+	else
+	{
+		size_t remaining = count - 1U;
+		m_createdObjects.reserve(m_createdObjects.size() + remaining);
+		parentWorld->ReserveObjects(remaining);
+
+		MemoryArena& arena = parentWorld->GetArena();
+		arena.Reserve(GetInstanceStorageSize(archetype) * remaining);
+		MemoryArena* previousArena = SetAllocationArena(&arena);
+
+		for (size_t i = 0U; i < remaining; ++i)
+		{
+			GameObject* newObject = archetype->Clone(parentWorld);
+			BinaryReader objectReader(prefab->m_data.data(), prefab->m_objectDataSize);
+			newObject->ReadBinary(objectReader);	// object's own fields only, components are copied
+
+			for (const Component* archetypeComp : archetype->m_components)
+			{
+				Component* component = archetypeComp->Clone();
+				component->SetOwner(newObject);
+				newObject->AddComponent(component);
+			}
+			newObject->Initialize();
+
+			AddCreatedObject(newObject);
+			parentWorld->AddObject(newObject);
+			out.push_back(newObject);
+		}
+		NotifyObjectListChanged();
+
+		SetAllocationArena(previousArena);
+	}
+
+	if (instanceOverride)
+	{
+		for (size_t i = 0U; i < count; ++i)
+		{
+			instanceOverride(out[firstIndex + i], i);
+		}
+	}
+}
+
 void GameObjectFactory::DeleteObject(GameObject* object)
 {
 	World* parentWorld = object->GetParentWorld();
@@ -72,17 +203,193 @@ void GameObjectFactory::DeleteObject(GameObject* object)
 	{
 		if (object == *objectIter)
 		{
+			m_objectsByID.erase(object->GetID());
 			delete object;
 			m_createdObjects.erase(objectIter);
+			NotifyObjectListChanged();
 			break;
 		}
 	}
 }
 
+EntityCommandBuffer& GameObjectFactory::GetCommandBuffer(void)
+{
+	return m_commandBuffer;
+}
+
+void GameObjectFactory::FlushCommands(void)
+{
+	if (m_commandBuffer.IsEmpty())
+	{
+		return;
+	}
+
+	typedef EntityCommandBuffer::Command Command;
+	typedef EntityCommandBuffer::CommandType CommandType;
+
+	m_commandBuffer.TakeCommands(m_pendingCommands);
+
+	/* Find out which targets are still alive, in a single pass over created objects */
+	std::vector<GameObject*> targets;
+	for (const Command& command : m_pendingCommands)
+	{
+		if (command.m_type != CommandType::Create)
+		{
+			targets.push_back(command.m_target);
+		}
+	}
+	std::sort(targets.begin(), targets.end());
+	targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+
+	std::vector<GameObject*> aliveTargets;
+	if (!targets.empty())
+	{
+		for (GameObject* object : m_createdObjects)
+		{
+			if (std::binary_search(targets.begin(), targets.end(), object))
+			{
+				aliveTargets.push_back(object);
+			}
+		}
+		std::sort(aliveTargets.begin(), aliveTargets.end());
+	}
+
+	std::vector<GameObject*> created;
+	std::vector<GameObject*> destroyed;
+	size_t index = 0U;
+	while (index < m_pendingCommands.size())
+	{
+		const Command& command = m_pendingCommands[index];
+		switch (command.m_type)
+		{
+		case CommandType::Create:
+		{ // commands are grouped by world and type, create each group in one batch
+			size_t groupEnd = index + 1U;
+			while (groupEnd < m_pendingCommands.size() && m_pendingCommands[groupEnd].m_type == CommandType::Create
+				&& m_pendingCommands[groupEnd].m_world == command.m_world && m_pendingCommands[groupEnd].m_typeName == command.m_typeName)
+			{
+				++groupEnd;
+			}
+
+			created.clear();
+			CreateNewObjects(command.m_typeName, groupEnd - index, command.m_world, created);
+			for (size_t i = 0U; i < created.size(); ++i)
+			{
+				if (m_pendingCommands[index + i].m_onCreated)
+				{
+					m_pendingCommands[index + i].m_onCreated(created[i]);
+				}
+			}
+			index = groupEnd;
+			continue;
+		}
+		case CommandType::AddComponent:
+			if (std::binary_search(aliveTargets.begin(), aliveTargets.end(), command.m_target) && command.m_target->GetID() == command.m_targetID)
+			{
+				std::map<std::string, Component*>::const_iterator typeIter = m_componentTypeRegister.find(command.m_typeName);
+				if (typeIter == m_componentTypeRegister.end())
+				{
+					fprintf(stderr, "GameObjectFactory::%s: component type \"%s\" not registered\n", __func__, command.m_typeName.c_str());
+					break;
+				}
+
+				World* parentWorld = command.m_target->GetParentWorld();
+				MemoryArena* previousArena = SetAllocationArena(parentWorld != nullptr ? &parentWorld->GetArena() : nullptr);
+				Component* component = typeIter->second->Clone();
+				component->SetOwner(command.m_target);
+				command.m_target->AddComponent(component);
+				SetAllocationArena(previousArena);
+
+				if (command.m_onAdded)
+				{
+					command.m_onAdded(component);
+				}
+			}
+			break;
+		case CommandType::Destroy:
+			// destroys are sorted by target, duplicates are skipped
+			if (std::binary_search(aliveTargets.begin(), aliveTargets.end(), command.m_target) && command.m_target->GetID() == command.m_targetID
+				&& (destroyed.empty() || destroyed.back() != command.m_target))
+			{
+				destroyed.push_back(command.m_target);
+			}
+			break;
+		default:
+			break;
+		}
+		++index;
+	}
+
+	DeleteObjects(destroyed);
+	m_pendingCommands.clear();
+}
+
+void GameObjectFactory::DeleteObjects(const std::vector<GameObject*>& objects)
+{
+	if (objects.empty())
+	{
+		return;
+	}
+
+	/* Remove from every world that owns any of the objects, then from the created objects list */
+	std::vector<World*> worlds;
+	for (GameObject* object : objects)
+	{
+		World* world = object->GetParentWorld();
+		if (std::find(worlds.begin(), worlds.end(), world) == worlds.end())
+		{
+			worlds.push_back(world);
+		}
+	}
+	for (World* world : worlds)
+	{
+		world->RemoveObjects(objects);
+	}
+
+	std::vector<GameObject*>::iterator newEnd = std::remove_if(m_createdObjects.begin(), m_createdObjects.end(),
+		[&objects](GameObject* object) { return std::binary_search(objects.begin(), objects.end(), object); });
+	m_createdObjects.erase(newEnd, m_createdObjects.end());
+
+	for (GameObject* object : objects)
+	{
+		m_objectsByID.erase(object->GetID());
+		delete object;
+	}
+	NotifyObjectListChanged();
+}
+
+void GameObjectFactory::DeleteWorldObjects(World* world, const std::vector<GameObject*>& worldObjects)
+{
+	/* Remove world's objects and their children in a single pass */
+	std::vector<GameObject*>::iterator newEnd = std::remove_if(m_createdObjects.begin(), m_createdObjects.end(),
+		[this, world](const GameObject* object)
+		{
+			if (object->GetParentWorld() != world)
+			{
+				return false;
+			}
+			m_objectsByID.erase(object->GetID());
+			return true;
+		});
+	m_createdObjects.erase(newEnd, m_createdObjects.end());
+
+	for (GameObject* object : worldObjects)
+	{
+		delete object;
+	}
+	NotifyObjectListChanged();
+}
+
 GameObject* GameObjectFactory::Clone(const GameObject* source)
 {
-	GameObject* newObject = source->Clone(const_cast<World*>(source->GetParentWorld()));
-	m_createdObjects.push_back(newObject);
+	World* parentWorld = const_cast<World*>(source->GetParentWorld());
+	MemoryArena* previousArena = SetAllocationArena(parentWorld != nullptr ? &parentWorld->GetArena() : nullptr);
+
+	GameObject* newObject = source->Clone(parentWorld);
+	AddCreatedObject(newObject);
+	NotifyObjectListChanged();
+
+	SetAllocationArena(previousArena);
 	return newObject;
 }
 
@@ -102,18 +409,290 @@ Messenger& GameObjectFactory::GetMessenger(void) const
 	return m_messenger;
 }
 
-void GameObjectFactory::ReadGameObjectData(const std::string& filePath)
+uint64_t GameObjectFactory::GetObjectListVersion(void) const
 {
-	std::string filename = StringUtility::ExtractFilenameFromPath(filePath);
-	if (m_parsedObjects.find(filename) == m_parsedObjects.end())
+	return m_objectListVersion.load();
+}
+
+void GameObjectFactory::NotifyObjectListChanged(void)
+{
+	++m_objectListVersion;
+}
+
+GameObject::BatchUpdateFunction GameObjectFactory::GetBatchUpdate(const std::string& type) const
+{
+	std::map<std::string, GameObject::BatchUpdateFunction>::const_iterator it = m_batchUpdates.find(type);
+	if (it == m_batchUpdates.end())
 	{
-		JSONDoc* parsedWorldData = JSONUtility::ParseFile(filePath);
-		m_parsedObjects.insert(std::make_pair(filename, parsedWorldData));
+		return &BatchUpdateVirtual;
+	}
+	return it->second;
+}
+
+void* GameObjectFactory::AllocateStorage(size_t size)
+{
+	size_t blockSize = size + sizeof(StorageHeader);
+	StorageHeader* header = nullptr;
+
+	if (m_allocationArena != nullptr)
+	{
+		header = static_cast<StorageHeader*>(m_allocationArena->Allocate(blockSize));
 	}
 	else
+	{
+		MemoryPool* pool = FindPool(size);
+		if (pool == nullptr)
+		{ // type was not registered, create a pool for its size
+			RegisterPool(size, "");
+			pool = FindPool(size);
+		}
+		header = static_cast<StorageHeader*>(pool->Allocate());
+	}
+
+	header->m_arena = m_allocationArena;
+	header->m_size = blockSize;
+	return header + 1;
+}
+
+void GameObjectFactory::ReleaseStorage(void* storage)
+{
+	if (storage == nullptr)
+	{
+		return;
+	}
+
+	StorageHeader* header = static_cast<StorageHeader*>(storage) - 1;
+	if (header->m_arena != nullptr)
+	{
+		header->m_arena->Free(header, header->m_size);
+		return;
+	}
+
+	MemoryPool* pool = FindPool(header->m_size - sizeof(StorageHeader));
+	if (pool == nullptr)
+	{
+		fprintf(stderr, "GameObjectFactory::%s: no pool found for storage of size %zu\n", __func__, header->m_size);
+		return;
+	}
+	pool->Free(header);
+}
+
+size_t GameObjectFactory::GetInstanceStorageSize(const GameObject* object) const
+{
+	/* Storage starts at the most derived object, header precedes it */
+	const StorageHeader* header = static_cast<const StorageHeader*>(dynamic_cast<const void*>(object)) - 1;
+	size_t size = header->m_size;
+	for (const Component* component : object->m_components)
+	{
+		header = static_cast<const StorageHeader*>(dynamic_cast<const void*>(component)) - 1;
+		size += header->m_size;
+	}
+	return size;
+}
+
+MemoryArena* GameObjectFactory::SetAllocationArena(MemoryArena* arena)
+{
+	MemoryArena* previousArena = m_allocationArena;
+	m_allocationArena = arena;
+	return previousArena;
+}
+
+void GameObjectFactory::ShowPoolStatistics(void) const
+{
+	ImGui::Begin("Object Pools");
+
+	size_t totalUsed = 0U;
+	size_t totalCapacity = 0U;
+
+	if (ImGui::BeginTable("Pools", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+	{
+		ImGui::TableSetupColumn("Types");
+		ImGui::TableSetupColumn("Block");
+		ImGui::TableSetupColumn("Used");
+		ImGui::TableSetupColumn("Peak");
+		ImGui::TableSetupColumn("Capacity");
+		ImGui::TableHeadersRow();
+
+		for (std::pair<size_t, MemoryPool*> it : m_pools)
+		{
+			const MemoryPool* pool = it.second;
+			std::map<size_t, std::string>::const_iterator nameIter = m_poolTypeNames.find(it.first);
+
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(nameIter != m_poolTypeNames.end() ? nameIter->second.c_str() : "");
+			ImGui::TableNextColumn();
+			ImGui::Text("%zu", pool->GetBlockSize());
+			ImGui::TableNextColumn();
+			ImGui::Text("%zu", pool->GetNumUsedBlocks());
+			ImGui::TableNextColumn();
+			ImGui::Text("%zu", pool->GetPeakUsedBlocks());
+			ImGui::TableNextColumn();
+			ImGui::Text("%zu (%zu chunks)", pool->GetCapacity(), pool->GetNumChunks());
+
+			totalUsed += pool->GetNumUsedBlocks() * pool->GetBlockSize();
+			totalCapacity += pool->GetCapacity() * pool->GetBlockSize();
+		}
+
+		ImGui::EndTable();
+	}
+
+	ImGui::Text("Total: %zu / %zu KB", totalUsed / 1024U, totalCapacity / 1024U);
+	ImGui::End();
+}
+
+void GameObjectFactory::RegisterPool(size_t size, const std::string& typeName)
+{
+	size_t blockSize = (size + sizeof(StorageHeader) + MemoryPool::BLOCK_ALIGNMENT - 1U) & ~(MemoryPool::BLOCK_ALIGNMENT - 1U);
+	if (m_pools.find(blockSize) == m_pools.end())
+	{
+		m_pools.insert({ blockSize, new MemoryPool(blockSize) });
+	}
+
+	if (!typeName.empty())
+	{
+		std::string& names = m_poolTypeNames[blockSize];
+		if (names.find(typeName) == std::string::npos)
+		{
+			names += names.empty() ? typeName : ", " + typeName;
+		}
+	}
+}
+
+MemoryPool* GameObjectFactory::FindPool(size_t size)
+{
+	size_t blockSize = (size + sizeof(StorageHeader) + MemoryPool::BLOCK_ALIGNMENT - 1U) & ~(MemoryPool::BLOCK_ALIGNMENT - 1U);
+	std::map<size_t, MemoryPool*>::const_iterator it = m_pools.find(blockSize);
+	if (it == m_pools.end())
+	{
+		return nullptr;
+	}
+	return it->second;
+}
+
+void GameObjectFactory::BatchUpdateVirtual(GameObject* const* objects, size_t count, float deltaTime)
+{
+	for (size_t i = 0U; i < count; ++i)
+	{
+		objects[i]->Update(deltaTime);
+	}
+}
+
+const JSONDoc* GameObjectFactory::FindObjectDocument(const std::string& type) const
+{
+	std::map<std::string, JSONDoc*>::const_iterator it = m_parsedObjects.find(type + FILEEXTENSION_GAMEOBJECT);
+	if (it == m_parsedObjects.end())
+	{
+		return nullptr;
+	}
+	return it->second;
+}
+
+void GameObjectFactory::ReadGameObjectData(const std::string& filePath)
+{
+	std::string filename = StringUtility::ExtractFilenameFromPath(filePath);
+	std::string type = filename.substr(0U, filename.size() - (sizeof(FILEEXTENSION_GAMEOBJECT) - 1U));
+	if (m_parsedObjects.find(filename) != m_parsedObjects.end() || m_prefabs.find(type) != m_prefabs.end())
 	{
 		fprintf(stderr, "GameObjectFactory::%s: \"%s\" already exists\n", __func__, filename.c_str());
+		return;
+	}
+
+	/* Use compiled prefab if its cache is up to date with the source file */
+	PrefabSource source = { filePath.substr(0U, filePath.size() - filename.size()) + type + FILEEXTENSION_PREFAB, 0U };
+	if (Prefab::HashFile(filePath, source.m_hash))
+	{
+		Prefab* prefab = new Prefab;
+		if (prefab->Load(source.m_cachePath, source.m_hash) && prefab->m_type == type && ResolvePrefab(prefab))
+		{
+			m_prefabs.insert({ type, prefab });
+			return;
+		}
+		delete prefab;
+		m_prefabSources.insert({ type, source });
+	}
+
+	JSONDoc* parsedWorldData = JSONUtility::ParseFile(filePath);
+	m_parsedObjects.insert(std::make_pair(filename, parsedWorldData));
+}
+
+const Prefab* GameObjectFactory::FindPrefab(const std::string& type) const
+{
+	std::map<std::string, Prefab*>::const_iterator it = m_prefabs.find(type);
+	if (it == m_prefabs.end())
+	{
+		return nullptr;
+	}
+	return it->second;
+}
+
+bool GameObjectFactory::ResolvePrefab(Prefab* prefab) const
+{
+	for (Prefab::ComponentRecord& record : prefab->m_components)
+	{
+		std::map<std::string, Component*>::const_iterator it = m_componentTypeRegister.find(record.m_type);
+		if (it == m_componentTypeRegister.end())
+		{
+			fprintf(stderr, "GameObjectFactory::%s: component type \"%s\" not registered\n", __func__, record.m_type.c_str());
+			return false;
+		}
+		record.m_prototype = it->second;
 	}
+	return true;
+}
+
+void GameObjectFactory::CompilePrefab(const std::string& type, const GameObject* object)
+{
+	Prefab* prefab = new Prefab;
+	prefab->m_type = type;
+
+	BinaryWriter writer(prefab->m_data);
+	object->WriteBinary(writer);
+	prefab->m_objectDataSize = writer.GetSize();
+
+	for (const Component* component : object->m_components)
+	{
+		size_t offset = writer.GetSize();
+		component->WriteBinary(writer);
+		prefab->m_components.push_back({ component->GetObjectTypeName(), nullptr, offset, writer.GetSize() - offset });
+	}
+
+	if (!ResolvePrefab(prefab))
+	{
+		delete prefab;
+		return;
+	}
+	m_prefabs.insert({ type, prefab });
+
+	/* Cache for the next start up */
+	std::map<std::string, PrefabSource>::iterator sourceIter = m_prefabSources.find(type);
+	if (sourceIter != m_prefabSources.end())
+	{
+		prefab->m_sourceHash = sourceIter->second.m_hash;
+		prefab->Save(sourceIter->second.m_cachePath);
+		m_prefabSources.erase(sourceIter);
+	}
+}
+
+GameObject* GameObjectFactory::InstantiatePrefab(const Prefab& prefab, const GameObject* prototype, World* parentWorld)
+{
+	GameObject* newObject = prototype->Clone(parentWorld);
+	const uint8_t* data = prefab.m_data.data();
+
+	BinaryReader objectReader(data, prefab.m_objectDataSize);
+	newObject->ReadBinary(objectReader);
+
+	for (const Prefab::ComponentRecord& record : prefab.m_components)
+	{
+		Component* component = record.m_prototype->Clone();
+		component->SetOwner(newObject);
+		BinaryReader componentReader(data + record.m_offset, record.m_size);
+		component->ReadBinary(componentReader);
+		newObject->AddComponent(component);
+	}
+
+	newObject->Initialize();
+	return newObject;
 }
 
 GameObject* GameObjectFactory::CreateNewObject_Internal(const std::string& type, World* parentWorld)
@@ -125,30 +704,50 @@ GameObject* GameObjectFactory::CreateNewObject_Internal(const std::string& type,
 		return nullptr;
 	}
 
+	MemoryArena* previousArena = SetAllocationArena(&parentWorld->GetArena());
+
+	const Prefab* prefab = FindPrefab(type);
+	if (prefab != nullptr)
+	{
+		GameObject* newObject = InstantiatePrefab(*prefab, mapIter->second, parentWorld);
+		SetAllocationArena(previousArena);
+
+		AddCreatedObject(newObject);
+		parentWorld->AddObject(newObject);
+		NotifyObjectListChanged();
+		return newObject;
+	}
+
 	GameObject* newObject = mapIter->second->Clone(parentWorld);
 
 	/* Locate parsed file for reading data */
-	std::string filename = type + FILEEXTENSION_GAMEOBJECT;
-	std::map<std::string, JSONDoc*>::const_iterator it = m_parsedObjects.find(filename);
-	if (it == m_parsedObjects.end())
+	const JSONDoc* document = FindObjectDocument(type);
+	if (document == nullptr)
 	{
-		fprintf(stderr, "GameObjectFactory: \"%s\" file not found\n", filename.c_str());
+		fprintf(stderr, "GameObjectFactory: \"%s\" file not found\n", (type + FILEEXTENSION_GAMEOBJECT).c_str());
 	}
 	else
 	{
-		JSONData typeData = JSONData(it->second, type);
+		JSONData typeData = JSONData(document, type);
 		if (!typeData.IsValid())
 		{
-			fprintf(stderr, "GameObjectFactory: file \"%s\" does not contain \"%s\" type data\n", filename.c_str(), type.c_str());
+			fprintf(stderr, "GameObjectFactory: file \"%s\" does not contain \"%s\" type data\n", (type + FILEEXTENSION_GAMEOBJECT).c_str(), type.c_str());
 		}
 		else
 		{
 			Deserialize(newObject, typeData);
+			if (newObject->m_children.empty())
+			{ // next instances of the type are created from compiled data, objects with children are not compiled
+				CompilePrefab(type, newObject);
+			}
 		}
 	}
 
-	m_createdObjects.push_back(newObject);
+	SetAllocationArena(previousArena);
+
+	AddCreatedObject(newObject);
 	parentWorld->AddObject(newObject);
+	NotifyObjectListChanged();
 
 	return newObject;
 }
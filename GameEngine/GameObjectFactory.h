@@ -16,18 +16,29 @@
 #ifndef GAMEOBJECTFACTORY_H
 #define GAMEOBJECTFACTORY_H
 
+#include <atomic>
+#include <functional>
 #include <map>
+#include <new>
+#include <utility>
 #include <vector>
 #include <string>
+#include <unordered_map>
 #include "GameObject.h"
 #include "Component.h"
+#include "EntityCommandBuffer.h"
 #include "Singleton.h"
 #include "Subscriber.h"
 #include "JSONUtility.h"
+#include "MemoryPool.h"
 
 #define FILEEXTENSION_GAMEOBJECT ".go"
+#define FILEEXTENSION_PREFAB ".goc"	// compiled prefab cache, stored next to its .go file
 
 class JSONData;
+class MemoryArena;
+class Prefab;
+class WakeObjectMessage;
 
 class GameObjectFactory : public Subscriber, public Singleton<GameObjectFactory>
 {
@@ -36,9 +47,9 @@ public:
 	~GameObjectFactory(void);
 
 	void RegisterMessages(void);
-	void ProcessMessage(const Message* message);
 
 	const std::vector<GameObject*>& GetObjectList(void) const;
+	GameObject* FindObject(uint64_t id) const;	// nullptr if no created object has the ID
 	
 	template <typename Type>
 	void GetComponentsOfType(std::vector<Type*>& list) const;
@@ -47,7 +58,21 @@ public:
 	template <typename Type>
 	Type* CreateNewObject(World* parentWorld);
 
+	// CreateNewObjects: creates count objects of a type, appends them to out. Type data is resolved once,
+	// instances copy the first object's components. instanceOverride is called for each object with its index
+	void CreateNewObjects(const std::string& type, size_t count, World* parentWorld, std::vector<GameObject*>& out,
+		const std::function<void(GameObject*, size_t)>& instanceOverride = nullptr);
+	template <typename Type>
+	void CreateNewObjects(size_t count, World* parentWorld, std::vector<Type*>& out,
+		const std::function<void(Type*, size_t)>& instanceOverride = nullptr);
+
 	void DeleteObject(GameObject* obj);
+	// Deferred structural changes: recorded from any thread, applied in FlushCommands at a sync point
+	EntityCommandBuffer& GetCommandBuffer(void);
+	void FlushCommands(void);
+
+	// DeleteWorldObjects: destroys all objects of a world, used on world teardown
+	void DeleteWorldObjects(World* world, const std::vector<GameObject*>& worldObjects);
 
 	GameObject* Clone(const GameObject* source);
 	Component* Clone(const Component* source) const;
@@ -55,27 +80,100 @@ public:
 	uint64_t GenerateID(void);
 	Messenger& GetMessenger(void) const;
 
+	// Object list version: changes when objects are created or destroyed and when objects or components
+	// are woken or put to sleep. Systems rebuild cached object lists when it changes
+	uint64_t GetObjectListVersion(void) const;
+	void NotifyObjectListChanged(void);
+
 	template <typename ObjType>
 	void RegisterObject(void);
 	template <typename CompType>
 	void RegisterComponent(void);
 
+	// GetBatchUpdate: update loop for objects of a type, nullptr if the type does not update
+	GameObject::BatchUpdateFunction GetBatchUpdate(const std::string& type) const;
+
+	// Storage for objects, components and colliders. Taken from the current allocation arena,
+	// or from per-size free list pools when no arena is set
+	void* AllocateStorage(size_t size);
+	void ReleaseStorage(void* storage);
+
+	// SetAllocationArena: sets arena used by AllocateStorage, returns previously set arena
+	MemoryArena* SetAllocationArena(MemoryArena* arena);
+
+	template <typename Type, typename... Args>
+	Type* ConstructInStorage(Args&&... args);
+	template <typename Type>
+	void DestroyInStorage(Type* object);
+
+	// Draws pool capacity and usage in an ImGui window
+	void ShowPoolStatistics(void) const;
+
 private:
+	void OnWakeObject(const WakeObjectMessage& msg);
+	void AddCreatedObject(GameObject* object);
+
+	// StorageHeader: precedes every block handed out by AllocateStorage, aligned so the object after it keeps block alignment
+	struct alignas(MemoryPool::BLOCK_ALIGNMENT) StorageHeader
+	{
+		MemoryArena* m_arena;	// arena the block belongs to, nullptr for pools
+		size_t m_size;	// block size including the header
+	};
+
+	void RegisterPool(size_t size, const std::string& typeName);
+	MemoryPool* FindPool(size_t size);
+
+	// BatchUpdate: calls ObjType::Update directly, objects have to be of ObjType
+	template <typename ObjType>
+	static void BatchUpdate(GameObject* const* objects, size_t count, float deltaTime);
+	static void BatchUpdateVirtual(GameObject* const* objects, size_t count, float deltaTime);	// for unregistered types
+	// GetInstanceStorageSize: storage used by an object and its components
+	size_t GetInstanceStorageSize(const GameObject* object) const;
+
+	const JSONDoc* FindObjectDocument(const std::string& type) const;
 	void ReadGameObjectData(const std::string& filePath);
 
+	/* Compiled prefabs */
+	const Prefab* FindPrefab(const std::string& type) const;
+	bool ResolvePrefab(Prefab* prefab) const;	// finds component prototypes, false if any is not registered
+	void CompilePrefab(const std::string& type, const GameObject* object);
+	GameObject* InstantiatePrefab(const Prefab& prefab, const GameObject* prototype, World* parentWorld);
+
 	GameObject* CreateNewObject_Internal(const std::string& type, World* parentWorld);
 
 	void Deserialize(GameObject* object, const JSONData& data);
 	void Deserialize(Component* component, const JSONData& data);
 
+	// DeleteObjects: removes and destroys objects in one pass over object lists. objects has to be sorted
+	void DeleteObjects(const std::vector<GameObject*>& objects);
+
 public:
 	std::map<std::string, GameObject*> m_objectTypeRegister;	// stores object type names and data
 	std::map<std::string, Component*> m_componentTypeRegister;	// stores component type names and data
 
 private:
+	// PrefabSource: where to cache a prefab compiled from a .go file
+	struct PrefabSource
+	{
+		std::string m_cachePath;
+		uint64_t m_hash;
+	};
+
 	std::map<std::string, JSONDoc*> m_parsedObjects;	// stores parsed JSON data
+	std::map<std::string, Prefab*> m_prefabs;	// compiled prefabs, keyed by object type
+	std::map<std::string, PrefabSource> m_prefabSources;	// .go files waiting to be compiled, keyed by object type
+	std::map<std::string, GameObject::BatchUpdateFunction> m_batchUpdates;	// keyed by object type
 	uint64_t m_IDCounter;	// unique ID counter, 
+	std::atomic<uint64_t> m_objectListVersion;
 	std::vector<GameObject*> m_createdObjects;	// stores objects that GOF creates
+	std::unordered_map<uint64_t, GameObject*> m_objectsByID;	// created objects keyed by ID
+
+	std::map<size_t, MemoryPool*> m_pools;	// storage pools, keyed by block size
+	std::map<size_t, std::string> m_poolTypeNames;	// names of registered types sharing a pool
+	MemoryArena* m_allocationArena;	// arena of the world objects are currently created for
+
+	EntityCommandBuffer m_commandBuffer;
+	std::vector<EntityCommandBuffer::Command> m_pendingCommands;	// commands being applied, kept to reuse storage
 };
 
 template <typename Type>
@@ -101,15 +199,66 @@ Type* GameObjectFactory::CreateNewObject(World* parentWorld)
 	return static_cast<Type*>(newObject);
 }
 
+template <typename Type>
+void GameObjectFactory::CreateNewObjects(size_t count, World* parentWorld, std::vector<Type*>& out,
+	const std::function<void(Type*, size_t)>& instanceOverride)
+{
+	std::vector<GameObject*> created;
+	std::function<void(GameObject*, size_t)> typedOverride = nullptr;
+	if (instanceOverride)
+	{
+		typedOverride = [&instanceOverride](GameObject* object, size_t index) { instanceOverride(static_cast<Type*>(object), index); };
+	}
+
+	CreateNewObjects(Type::GetClassTypeName(), count, parentWorld, created, typedOverride);
+
+	out.reserve(out.size() + created.size());
+	for (GameObject* object : created)
+	{
+		out.push_back(static_cast<Type*>(object));
+	}
+}
+
+template <typename Type, typename... Args>
+Type* GameObjectFactory::ConstructInStorage(Args&&... args)
+{
+	void* storage = AllocateStorage(sizeof(Type));
+	return new (storage) Type(std::forward<Args>(args)...);
+}
+
+template <typename Type>
+void GameObjectFactory::DestroyInStorage(Type* object)
+{
+	if (object == nullptr)
+	{
+		return;
+	}
+
+	object->~Type();
+	ReleaseStorage(object);
+}
+
 template <typename ObjType>
 void GameObjectFactory::RegisterObject(void)
 {
+	RegisterPool(sizeof(ObjType), ObjType::GetClassTypeName());
 	m_objectTypeRegister.insert({ ObjType::GetClassTypeName(), new ObjType });
+	m_batchUpdates.insert({ ObjType::GetClassTypeName(), ObjType::HAS_UPDATE ? &BatchUpdate<ObjType> : nullptr });
+}
+
+template <typename ObjType>
+void GameObjectFactory::BatchUpdate(GameObject* const* objects, size_t count, float deltaTime)
+{
+	for (size_t i = 0U; i < count; ++i)
+	{
+		static_cast<ObjType*>(objects[i])->ObjType::Update(deltaTime);
+	}
 }
 
 template <typename CompType>
 void GameObjectFactory::RegisterComponent(void)
 {
+	RegisterPool(sizeof(CompType), CompType::GetClassTypeName());
 	m_componentTypeRegister.insert({ CompType::GetClassTypeName(), new CompType });
 }
 
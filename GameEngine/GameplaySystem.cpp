@@ -15,6 +15,7 @@
 
 #include "GameplaySystem.h"
 #include "GameObjectFactory.h"
+#include "GraphicsComponent.h"
 #include "InputComponent.h"
 #include "Camera.h"
 #include "App.h"
@@ -33,6 +34,11 @@ bool GameplaySystem::Initialize(INIReader* ini)
 	return true;
 }
 
+const char* GameplaySystem::GetName(void) const
+{
+	return "GameplaySystem";
+}
+
 void GameplaySystem::Update(float deltaTime)
 {
 	m_worldManager->UpdateWorlds(deltaTime);
@@ -52,3 +58,26 @@ void GameplaySystem::RegisterComponents(void) const
 	InputComponent::Register();
 	Camera::Register();
 }
+
+void GameplaySystem::DeclareAccess(SystemAccess& access) const
+{
+	access.m_simulation = true;
+}
+
+bool GameplaySystem::AreGraphicsInitialized(const std::vector<GameObject*>& objects)
+{
+	std::vector<GraphicsComponent*> graphics;
+	for (const GameObject* obj : objects)
+	{
+		graphics.clear();
+		obj->QueryComponents(graphics);
+		for (const GraphicsComponent* graphicsComp : graphics)
+		{
+			if (graphicsComp->IsWaitingForResources())
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
@@ -19,6 +19,7 @@
 #include "ISystem.h"
 #include "WorldManager.h"
 
+class GameObject;
 class GameObjectFactory;
 
 class GameplaySystem : public ISystem
@@ -30,11 +31,17 @@ public:
 	bool Initialize(INIReader* ini) override;
 	void Update(float deltaTime) override;
 	void Exit(void) override;
+	const char* GetName(void) const override;
 
 	void RegisterMessages(void) override;
 	void ProcessMessage(const Message* message) override;
 
 	void RegisterComponents(void) const override;
+	void DeclareAccess(SystemAccess& access) const override;	// default access on the simulation tick
+
+protected:
+	// AreGraphicsInitialized: true once every graphics component of the objects got replies to its material and model requests
+	static bool AreGraphicsInitialized(const std::vector<GameObject*>& objects);
 
 protected:
 	WorldManager* m_worldManager;
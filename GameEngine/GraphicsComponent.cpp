@@ -14,6 +14,7 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "GraphicsComponent.h"
+#include "BinaryStream.h"
 #include "GameObjectFactory.h"
 #include "Message.h"
 #include "Messenger.h"
@@ -30,14 +31,45 @@ GraphicsComponent::GraphicsComponent(void)
 	: Component(0U, nullptr)
 	, m_material(nullptr)
 	, m_model(nullptr)
+	, m_pendingRequests(0U)
+	, m_hasMissingResource(false)
 {}
 
 GraphicsComponent::GraphicsComponent(uint64_t id, GameObject* owner)
 	: Component(id, owner)
 	, m_material(nullptr)
 	, m_model(nullptr)
+	, m_pendingRequests(0U)
+	, m_hasMissingResource(false)
 {}
 
+GraphicsComponent::GraphicsComponent(const GraphicsComponent& rhs)
+	: Component(rhs)
+	, m_material(nullptr)
+	, m_model(rhs.m_model)
+	, m_pendingRequests(0U)
+	, m_hasMissingResource(rhs.m_hasMissingResource)
+{
+	if (rhs.m_material != nullptr)
+	{
+		m_material = new Material(*rhs.m_material);
+		m_materialName = rhs.m_materialName;
+	}
+	else if (!rhs.m_materialName.empty())
+	{
+		RequestMaterial(rhs.m_materialName);
+	}
+
+	if (m_model != nullptr)
+	{
+		m_modelName = rhs.m_modelName;
+	}
+	else if (!rhs.m_modelName.empty())
+	{
+		RequestModel(rhs.m_modelName);
+	}
+}
+
 GraphicsComponent::~GraphicsComponent(void)
 {
 	if (m_material != nullptr)
@@ -64,6 +96,27 @@ void GraphicsComponent::Deserialize(const JSONData& source)
 	}
 }
 
+void GraphicsComponent::WriteBinary(BinaryWriter& writer) const
+{
+	writer.WriteString(m_materialName);
+	writer.WriteString(m_modelName);
+}
+
+void GraphicsComponent::ReadBinary(BinaryReader& reader)
+{
+	std::string resourceName;
+
+	if (reader.ReadString(resourceName) && !resourceName.empty())
+	{
+		RequestMaterial(resourceName);
+	}
+
+	if (reader.ReadString(resourceName) && !resourceName.empty())
+	{
+		RequestModel(resourceName);
+	}
+}
+
 Component* GraphicsComponent::Clone(void) const
 {
 	Component* clone = new GraphicsComponent(*this);
@@ -81,14 +134,66 @@ const std::string& GraphicsComponent::GetClassTypeName(void)
 	return name;
 }
 
+void GraphicsComponent::RegisterMessages(void)
+{
+	m_messenger.SubscribeAddressed<MaterialReadyMessage>(this, &GraphicsComponent::OnMaterialReady);
+	m_messenger.SubscribeAddressed<ModelReadyMessage>(this, &GraphicsComponent::OnModelReady);
+}
+
+void GraphicsComponent::OnMaterialReady(const MaterialReadyMessage& msg)
+{
+	--m_pendingRequests;
+	if (m_material != nullptr)
+	{
+		delete m_material;
+	}
+
+	if (msg.m_material != nullptr)
+	{
+		m_material = new Material(*msg.m_material);
+	}
+	else
+	{ // default material for game code that recolors without checking, the component is not drawn
+		m_material = new Material();
+		m_hasMissingResource = true;
+	}
+
+	if (m_model != nullptr && !m_hasMissingResource)
+	{
+		SetInitialized(true);
+	}
+}
+
+void GraphicsComponent::OnModelReady(const ModelReadyMessage& msg)
+{
+	--m_pendingRequests;
+	m_model = msg.m_model;
+	m_hasMissingResource |= m_model == nullptr;
+	if (m_material != nullptr && !m_hasMissingResource)
+	{
+		SetInitialized(true);
+	}
+}
+
 void GraphicsComponent::RequestMaterial(const std::string& materialName)
 {
-	MaterialRequestMessage msg(materialName, *this);
+	m_materialName = materialName;
+	++m_pendingRequests;
+	RegisterMessages();	// reply is addressed to this component
+	MaterialRequestMessage msg(materialName, m_messenger.GetAddress(this));
 	m_messenger.Send(msg);
 }
 
 void GraphicsComponent::RequestModel(const std::string& modelName)
 {
-	ModelRequestMessage msg(modelName, *this);
+	m_modelName = modelName;
+	++m_pendingRequests;
+	RegisterMessages();
+	ModelRequestMessage msg(modelName, m_messenger.GetAddress(this));
 	m_messenger.Send(msg);
 }
+
+bool GraphicsComponent::IsWaitingForResources(void) const
+{
+	return m_pendingRequests > 0U;
+}
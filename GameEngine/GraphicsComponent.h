@@ -19,32 +19,51 @@
 #include "Component.h"
 
 class Material;
+class MaterialReadyMessage;
 class Model;
+class ModelReadyMessage;
 
 class GraphicsComponent : public Component
 {
 public:
 	GraphicsComponent(void);
 	GraphicsComponent(uint64_t id, GameObject* owner);
-	GraphicsComponent(const GraphicsComponent& rhs) = default;
+	GraphicsComponent(const GraphicsComponent& rhs);
 	~GraphicsComponent(void);
 
 	static void Register(void);
 
 	void Deserialize(const JSONData& source) override;
+	void WriteBinary(BinaryWriter& writer) const override;
+	void ReadBinary(BinaryReader& reader) override;
 
 	Component* Clone(void) const override;
 
+	void RegisterMessages(void) override;
+
 	const std::string& GetObjectTypeName(void) const override;
 	static const std::string& GetClassTypeName(void);
 
-	// Sends a message requesting material/mesh from GraphicsSystem
+	// Sends a message requesting material/mesh from GraphicsSystem, the reply is addressed to this component
 	void RequestMaterial(const std::string& materialName);
 	void RequestModel(const std::string& modelName);
+	// IsWaitingForResources: true until every request is answered. Components with a missing resource stay uninitialized and are not drawn
+	bool IsWaitingForResources(void) const;
 
 public:
 	Material* m_material;
 	Model* m_model;
+
+private:
+	void OnMaterialReady(const MaterialReadyMessage& msg);
+	void OnModelReady(const ModelReadyMessage& msg);
+
+private:
+	/* Requested resource names, copies request the resources again if they are not assigned yet */
+	std::string m_materialName;
+	std::string m_modelName;
+	uint32_t m_pendingRequests;
+	bool m_hasMissingResource;	// GraphicsSystem replied that a requested resource does not exist
 };
 
 #endif
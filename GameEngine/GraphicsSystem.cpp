@@ -50,6 +50,11 @@ GraphicsSystem::~GraphicsSystem(void)
 	delete m_backBuffer;
 }
 
+const char* GraphicsSystem::GetName(void) const
+{
+	return "GraphicsSystem";
+}
+
 bool GraphicsSystem::Initialize(INIReader* ini)
 {
 	FileRequestMessage frm;
@@ -360,8 +365,7 @@ bool GraphicsSystem::Initialize(INIReader* ini)
 
 void GraphicsSystem::Update(float deltaTime)
 {
-	m_graphicsComponents.clear();
-	m_renderPackages.clear();
+	m_renderList.Clear();
 
 	Camera* camera = m_worldManager->GetActiveWorld()->GetCamera();
 	if (camera != nullptr)
@@ -387,36 +391,7 @@ void GraphicsSystem::Update(float deltaTime)
 			fprintf(stderr, "GraphicsSystem::%s: failed to map CameraBuffer\n", __func__);
 		}
 
-		const std::vector<GameObject*>& objects = m_GOF->GetObjectList();
-		std::vector<GraphicsComponent*> graphics;
-		std::vector<SceneComponent*> scene;
-
-		for (GameObject* obj : objects)
-		{
-			obj->QueryComponents(graphics);
-			m_graphicsComponents.insert(m_graphicsComponents.end(), graphics.begin(), graphics.end());
-			obj->QueryComponents(scene);
-
-			if (!scene.empty())
-			{
-				for (GraphicsComponent* graphicsComp : graphics)
-				{
-					if (graphicsComp->IsInitialized())
-					{
-						RenderPackage renderPackage = { graphicsComp, scene[0] };
-						m_renderPackages.push_back(renderPackage);
-					}
-				}
-			}
-			else
-			{
-				fprintf(stderr, "GraphicsSystem::%s: %s does not contain SceneComponent\n",
-					__func__, obj->GetObjectTypeName().c_str());
-			}
-
-			graphics.clear();
-			scene.clear();
-		}
+		m_renderList.Build(*m_GOF);
 	}
 
 	Render(deltaTime);
@@ -502,162 +477,160 @@ void GraphicsSystem::Exit(void)
 
 void GraphicsSystem::RegisterMessages(void)
 {
-	m_messenger.RegisterMessage<WindowResizeMessage>(this);
-	m_messenger.RegisterMessage<MaterialRequestMessage>(this);
-	m_messenger.RegisterMessage<ModelRequestMessage>(this);
-	m_messenger.RegisterMessage<AssignTextureToMaterialMessage>(this);
-	m_messenger.RegisterMessage<AssignMeshToModelMessage>(this);
+	m_messenger.Subscribe<WindowResizeMessage>(this, &GraphicsSystem::OnWindowResize);
+	m_messenger.Subscribe<MaterialRequestMessage>(this, &GraphicsSystem::OnMaterialRequest);
+	m_messenger.Subscribe<ModelRequestMessage>(this, &GraphicsSystem::OnModelRequest);
+	m_messenger.Subscribe<AssignTextureToMaterialMessage>(this, &GraphicsSystem::OnAssignTextureToMaterial);
+	m_messenger.Subscribe<AssignMeshToModelMessage>(this, &GraphicsSystem::OnAssignMeshToModel);
+}
+
+void GraphicsSystem::OnWindowResize(const WindowResizeMessage& msg)
+{
+	ResizeSwapChain(msg.m_width, msg.m_height);
+	m_projectionMatrix = Matrix::PerspectiveLH(msg.m_width, msg.m_height, 0.1f, 100.0f);
+}
+
+void GraphicsSystem::OnMaterialRequest(const MaterialRequestMessage& msg)
+{
+	std::map<std::string, Material*>::const_iterator iter = m_materials.find(msg.m_materialName);
+	if (iter != m_materials.end())
+	{
+		m_messenger.SendTo(msg.m_replyAddress, MaterialReadyMessage(iter->second));
+	}
+	else
+	{ // requester would wait for the reply forever
+		fprintf(stderr, "GraphicsSystem::%s: material \"%s\" not found\n", __func__, msg.m_materialName.c_str());
+		m_messenger.SendTo(msg.m_replyAddress, MaterialReadyMessage(nullptr));
+	}
 }
 
-void GraphicsSystem::ProcessMessage(const Message* message)
+void GraphicsSystem::OnModelRequest(const ModelRequestMessage& msg)
 {
-	if (message->IsType<WindowResizeMessage>())
+	std::map<std::string, Model*>::const_iterator iter = m_models.find(msg.m_modelName);
+	if (iter != m_models.end())
 	{
-		const WindowResizeMessage* msg = static_cast<const WindowResizeMessage*>(message);
-		ResizeSwapChain(msg->m_width, msg->m_height);
-		m_projectionMatrix = Matrix::PerspectiveLH(msg->m_width, msg->m_height, 0.1f, 100.0f);
+		m_messenger.SendTo(msg.m_replyAddress, ModelReadyMessage(iter->second));
 	}
-	else if (message->IsType<MaterialRequestMessage>())
+	else
 	{
-		const MaterialRequestMessage* msg = static_cast<const MaterialRequestMessage*>(message);
-		std::map<std::string, Material*>::const_iterator iter = m_materials.find(msg->m_materialName);
-		if (iter != m_materials.end())
-		{
-			msg->m_componentRef.m_material = new Material(*iter->second);
-			if (msg->m_componentRef.m_model != nullptr)
-			{
-				msg->m_componentRef.SetInitialized(true);
-			}
-		}
+		fprintf(stderr, "GraphicsSystem::%s: model \"%s\" not found\n", __func__, msg.m_modelName.c_str());
+		m_messenger.SendTo(msg.m_replyAddress, ModelReadyMessage(nullptr));
 	}
-	else if (message->IsType<AssignTextureToMaterialMessage>())
+}
+
+void GraphicsSystem::OnAssignTextureToMaterial(const AssignTextureToMaterialMessage& msg)
+{
+	std::map<std::string, Material*>::const_iterator materialIter = m_materials.find(msg.m_materialName);
+	if (materialIter != m_materials.end())
 	{
-		const AssignTextureToMaterialMessage* msg = static_cast<const AssignTextureToMaterialMessage*>(message);
-		std::map<std::string, Material*>::const_iterator materialIter = m_materials.find(msg->m_materialName);
-		if (materialIter != m_materials.end())
+		std::map<std::string, Texture2D*>::const_iterator textureIter = m_textures.find(msg.m_textureName);
+		if (textureIter != m_textures.end())
 		{
-			std::map<std::string, Texture2D*>::const_iterator textureIter = m_textures.find(msg->m_textureName);
-			if (textureIter != m_textures.end())
-			{
-				materialIter->second->m_texture = textureIter->second;
-			}
-			else
-			{
-				fprintf(stderr, "GraphicsSystem::%s: texture \"%s\" not found\n", __func__, msg->m_textureName.c_str());
-			}
+			materialIter->second->m_texture = textureIter->second;
 		}
 		else
 		{
-			fprintf(stderr, "GraphicsSystem::%s: material \"%s\" not found\n", __func__, msg->m_materialName.c_str());
+			fprintf(stderr, "GraphicsSystem::%s: texture \"%s\" not found\n", __func__, msg.m_textureName.c_str());
 		}
 	}
-	else if (message->IsType<AssignMeshToModelMessage>())
+	else
+	{
+		fprintf(stderr, "GraphicsSystem::%s: material \"%s\" not found\n", __func__, msg.m_materialName.c_str());
+	}
+}
+
+void GraphicsSystem::OnAssignMeshToModel(const AssignMeshToModelMessage& msg)
+{
+	std::map<std::string, Model*>::const_iterator modelIter = m_models.find(msg.m_modelName);
+	if (modelIter != m_models.end())
 	{
-		const AssignMeshToModelMessage* msg = static_cast<const AssignMeshToModelMessage*>(message);
-		std::map<std::string, Model*>::const_iterator modelIter = m_models.find(msg->m_modelName);
-		if (modelIter != m_models.end())
+		// Hack - not loading from file
+		// Create Vertex buffers
+		ID3D11Buffer* buffer = nullptr;
+		if (msg.m_modelName == "VertexColorQuad")
 		{
-			// Hack - not loading from file
-			// Create Vertex buffers
-			ID3D11Buffer* buffer = nullptr;
-			if (msg->m_modelName == "VertexColorQuad")
+			VertexColor vertexColor[6];
+			vertexColor[0].m_position = { -0.5f, 0.5f, 0.0f };
+			vertexColor[1].m_position = { -0.5f, -0.5f, 0.0f };
+			vertexColor[2].m_position = { 0.5f, 0.5f, 0.0f };
+			vertexColor[3].m_position = { -0.5f, -0.5f, 0.0f };
+			vertexColor[4].m_position = { 0.5f, -0.5f, 0.0f };
+			vertexColor[5].m_position = { 0.5f, 0.5f, 0.0f };
+
+			vertexColor[0].m_color = { 1.0f, 1.0f, 1.0f, 1.0f };
+			vertexColor[1].m_color = { 1.0f, 1.0f, 1.0f, 1.0f };
+			vertexColor[2].m_color = { 1.0f, 1.0f, 1.0f, 1.0f };
+			vertexColor[3].m_color = { 1.0f, 1.0f, 1.0f, 1.0f };
+			vertexColor[4].m_color = { 1.0f, 1.0f, 1.0f, 1.0f };
+			vertexColor[5].m_color = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+			buffer = CreateVertexBuffer(6U, vertexColor);
+			if (buffer == nullptr)
 			{
-				VertexColor vertexColor[6];
-				vertexColor[0].m_position = { -0.5f, 0.5f, 0.0f };
-				vertexColor[1].m_position = { -0.5f, -0.5f, 0.0f };
-				vertexColor[2].m_position = { 0.5f, 0.5f, 0.0f };
-				vertexColor[3].m_position = { -0.5f, -0.5f, 0.0f };
-				vertexColor[4].m_position = { 0.5f, -0.5f, 0.0f };
-				vertexColor[5].m_position = { 0.5f, 0.5f, 0.0f };
-
-				vertexColor[0].m_color = { 1.0f, 1.0f, 1.0f, 1.0f };
-				vertexColor[1].m_color = { 1.0f, 1.0f, 1.0f, 1.0f };
-				vertexColor[2].m_color = { 1.0f, 1.0f, 1.0f, 1.0f };
-				vertexColor[3].m_color = { 1.0f, 1.0f, 1.0f, 1.0f };
-				vertexColor[4].m_color = { 1.0f, 1.0f, 1.0f, 1.0f };
-				vertexColor[5].m_color = { 1.0f, 1.0f, 1.0f, 1.0f };
-
-				buffer = CreateVertexBuffer(6U, vertexColor);
-				if (buffer == nullptr)
-				{
-					fprintf(stderr, "GraphicsSystem::%s: Failed to create VertexColor buffer\n", __func__);
-					return;
-				}
-
-				modelIter->second->m_vertexBuffer = buffer;
+				fprintf(stderr, "GraphicsSystem::%s: Failed to create VertexColor buffer\n", __func__);
+				return;
 			}
-			if (msg->m_modelName == "VertexTexCoordQuad")
-			{
-				VertexTexCoord vertexTexCoord[6];
-				vertexTexCoord[0].m_position = { -0.5f, 0.5f, 0.0f };
-				vertexTexCoord[1].m_position = { -0.5f, -0.5f, 0.0f };
-				vertexTexCoord[2].m_position = { 0.5f, 0.5f, 0.0f };
-				vertexTexCoord[3].m_position = { -0.5f, -0.5f, 0.0f };
-				vertexTexCoord[4].m_position = { 0.5f, -0.5f, 0.0f };
-				vertexTexCoord[5].m_position = { 0.5f, 0.5f, 0.0f };
-
-				vertexTexCoord[0].m_texCoord = { 0.0f, 0.0f };
-				vertexTexCoord[1].m_texCoord = { 0.0f, 1.0f };
-				vertexTexCoord[2].m_texCoord = { 1.0f, 0.0f };
-				vertexTexCoord[3].m_texCoord = { 0.0f, 1.0f };
-				vertexTexCoord[4].m_texCoord = { 1.0f, 1.0f };
-				vertexTexCoord[5].m_texCoord = { 1.0f, 0.0f };
-
-				buffer = CreateVertexBuffer(6U, vertexTexCoord);
-				if (buffer == nullptr)
-				{
-					fprintf(stderr, "GraphicsSystem::%s: Failed to create VertexTexCoord buffer\n", __func__);
-					return;
-				}
-
-				modelIter->second->m_vertexBuffer = buffer;
-			}
-			if (msg->m_modelName == "VertexTexCoordColorQuad")
+
+			modelIter->second->m_vertexBuffer = buffer;
+		}
+		if (msg.m_modelName == "VertexTexCoordQuad")
+		{
+			VertexTexCoord vertexTexCoord[6];
+			vertexTexCoord[0].m_position = { -0.5f, 0.5f, 0.0f };
+			vertexTexCoord[1].m_position = { -0.5f, -0.5f, 0.0f };
+			vertexTexCoord[2].m_position = { 0.5f, 0.5f, 0.0f };
+			vertexTexCoord[3].m_position = { -0.5f, -0.5f, 0.0f };
+			vertexTexCoord[4].m_position = { 0.5f, -0.5f, 0.0f };
+			vertexTexCoord[5].m_position = { 0.5f, 0.5f, 0.0f };
+
+			vertexTexCoord[0].m_texCoord = { 0.0f, 0.0f };
+			vertexTexCoord[1].m_texCoord = { 0.0f, 1.0f };
+			vertexTexCoord[2].m_texCoord = { 1.0f, 0.0f };
+			vertexTexCoord[3].m_texCoord = { 0.0f, 1.0f };
+			vertexTexCoord[4].m_texCoord = { 1.0f, 1.0f };
+			vertexTexCoord[5].m_texCoord = { 1.0f, 0.0f };
+
+			buffer = CreateVertexBuffer(6U, vertexTexCoord);
+			if (buffer == nullptr)
 			{
-				VertexTexCoordColor vertexTexCoordColor[6];
-				vertexTexCoordColor[0].m_position = { -0.5f, 0.5f, 0.0f };
-				vertexTexCoordColor[1].m_position = { -0.5f, -0.5f, 0.0f };
-				vertexTexCoordColor[2].m_position = { 0.5f, 0.5f, 0.0f };
-				vertexTexCoordColor[3].m_position = { -0.5f, -0.5f, 0.0f };
-				vertexTexCoordColor[4].m_position = { 0.5f, -0.5f, 0.0f };
-				vertexTexCoordColor[5].m_position = { 0.5f, 0.5f, 0.0f };
-
-				vertexTexCoordColor[0].m_texCoord = { 0.0f, 0.0f };
-				vertexTexCoordColor[1].m_texCoord = { 0.0f, 1.0f };
-				vertexTexCoordColor[2].m_texCoord = { 1.0f, 0.0f };
-				vertexTexCoordColor[3].m_texCoord = { 0.0f, 1.0f };
-				vertexTexCoordColor[4].m_texCoord = { 1.0f, 1.0f };
-				vertexTexCoordColor[5].m_texCoord = { 1.0f, 0.0f };
-
-				vertexTexCoordColor[0].m_color = { 1.0f, 1.0f, 1.0f, 1.0f };
-				vertexTexCoordColor[1].m_color = { 1.0f, 1.0f, 1.0f, 1.0f };
-				vertexTexCoordColor[2].m_color = { 1.0f, 1.0f, 1.0f, 1.0f };
-				vertexTexCoordColor[3].m_color = { 1.0f, 1.0f, 1.0f, 1.0f };
-				vertexTexCoordColor[4].m_color = { 1.0f, 1.0f, 1.0f, 1.0f };
-				vertexTexCoordColor[5].m_color = { 1.0f, 1.0f, 1.0f, 1.0f };
-
-				buffer = CreateVertexBuffer(6U, vertexTexCoordColor);
-				if (buffer == nullptr)
-				{
-					fprintf(stderr, "GraphicsSystem::%s: Failed to create VertexTexCoordColor buffer\n", __func__);
-					return;
-				}
-
-				modelIter->second->m_vertexBuffer = buffer;
+				fprintf(stderr, "GraphicsSystem::%s: Failed to create VertexTexCoord buffer\n", __func__);
+				return;
 			}
+
+			modelIter->second->m_vertexBuffer = buffer;
 		}
-	}
-	else if (message->IsType<ModelRequestMessage>())
-	{
-		const ModelRequestMessage* msg = static_cast<const ModelRequestMessage*>(message);
-		std::map<std::string, Model*>::const_iterator iter = m_models.find(msg->m_modelName);
-		if (iter != m_models.end())
+		if (msg.m_modelName == "VertexTexCoordColorQuad")
 		{
-			msg->m_componentRef.m_model = iter->second;
-			if (msg->m_componentRef.m_material != nullptr)
+			VertexTexCoordColor vertexTexCoordColor[6];
+			vertexTexCoordColor[0].m_position = { -0.5f, 0.5f, 0.0f };
+			vertexTexCoordColor[1].m_position = { -0.5f, -0.5f, 0.0f };
+			vertexTexCoordColor[2].m_position = { 0.5f, 0.5f, 0.0f };
+			vertexTexCoordColor[3].m_position = { -0.5f, -0.5f, 0.0f };
+			vertexTexCoordColor[4].m_position = { 0.5f, -0.5f, 0.0f };
+			vertexTexCoordColor[5].m_position = { 0.5f, 0.5f, 0.0f };
+
+			vertexTexCoordColor[0].m_texCoord = { 0.0f, 0.0f };
+			vertexTexCoordColor[1].m_texCoord = { 0.0f, 1.0f };
+			vertexTexCoordColor[2].m_texCoord = { 1.0f, 0.0f };
+			vertexTexCoordColor[3].m_texCoord = { 0.0f, 1.0f };
+			vertexTexCoordColor[4].m_texCoord = { 1.0f, 1.0f };
+			vertexTexCoordColor[5].m_texCoord = { 1.0f, 0.0f };
+
+			vertexTexCoordColor[0].m_color = { 1.0f, 1.0f, 1.0f, 1.0f };
+			vertexTexCoordColor[1].m_color = { 1.0f, 1.0f, 1.0f, 1.0f };
+			vertexTexCoordColor[2].m_color = { 1.0f, 1.0f, 1.0f, 1.0f };
+			vertexTexCoordColor[3].m_color = { 1.0f, 1.0f, 1.0f, 1.0f };
+			vertexTexCoordColor[4].m_color = { 1.0f, 1.0f, 1.0f, 1.0f };
+			vertexTexCoordColor[5].m_color = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+			buffer = CreateVertexBuffer(6U, vertexTexCoordColor);
+			if (buffer == nullptr)
 			{
-				msg->m_componentRef.SetInitialized(true);
+				fprintf(stderr, "GraphicsSystem::%s: Failed to create VertexTexCoordColor buffer\n", __func__);
+				return;
 			}
+
+			modelIter->second->m_vertexBuffer = buffer;
 		}
 	}
 }
@@ -667,6 +640,17 @@ void GraphicsSystem::RegisterComponents(void) const
 	GraphicsComponent::Register();
 }
 
+void GraphicsSystem::DeclareAccess(SystemAccess& access) const
+{
+	access.m_writesAll = false;
+	access.m_mainThread = true;	// D3D11 immediate context and ImGui rendering
+	if (access.m_writes.empty())
+	{
+		access.m_reads = { "GameObject", "SceneComponent", "GraphicsComponent", "Camera" };
+		access.m_writes = { "GraphicsResources" };
+	}
+}
+
 ID3D11Buffer* GraphicsSystem::CreateConstantBuffer(UINT size, const void* data) const
 {
 	HRESULT result;
@@ -855,7 +839,8 @@ void GraphicsSystem::Render(float deltaTime) const
 
 void GraphicsSystem::RenderPass(float deltaTime) const
 {
-	if (m_renderPackages.empty())
+	const std::vector<RenderPackage>& renderPackages = m_renderList.GetPackages();
+	if (renderPackages.empty())
 	{
 		return;
 	}
@@ -925,7 +910,10 @@ void GraphicsSystem::RenderPass(float deltaTime) const
 
 	m_deviceContext->VSSetShader(vertexShader->second, nullptr, 0);
 
-	for (const RenderPackage& rp : m_renderPackages)
+	/* Objects are drawn between the last two simulation ticks */
+	uint64_t tick = m_appPtr->GetSimulationTick();
+	float alpha = m_appPtr->GetInterpolationAlpha();
+	for (const RenderPackage& rp : renderPackages)
 	{
 		const std::string& blendType = rp.m_graphicsComponent->m_material->m_blend;
 		float blendFactor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
@@ -942,7 +930,7 @@ void GraphicsSystem::RenderPass(float deltaTime) const
 		if (result == S_OK)
 		{
 			MeshBuffer* buffer = static_cast<MeshBuffer*>(mappedSubr.pData);
-			buffer->m_world = rp.m_sceneComponent->GetTransform().GetTransformMatrix();
+			buffer->m_world = rp.m_sceneComponent->GetInterpolatedTransform(tick, alpha);
 			buffer->m_color = rp.m_graphicsComponent->m_material->m_color;
 
 			m_deviceContext->Unmap(meshBuffer->second, 0U);
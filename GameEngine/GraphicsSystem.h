@@ -23,6 +23,7 @@
 #include "StringUtility.h"
 #include "Matrix.h"
 #include "Vector2.h"
+#include "RenderList.h"
 #include "DirectXUtil.h"
 #include <D3DCompiler.h>
 
@@ -32,6 +33,7 @@
 #define GRAPHICS_DEBUG 0
 #endif
 
+class GameObject;
 class GameObjectFactory;
 class WorldManager;
 class GraphicsComponent;
@@ -41,15 +43,14 @@ class Texture2D;
 class RenderTarget;
 class Material;
 class Model;
+class WindowResizeMessage;
+class MaterialRequestMessage;
+class ModelRequestMessage;
+class AssignTextureToMaterialMessage;
+class AssignMeshToModelMessage;
 struct ID3D10Blob;
 typedef ID3D10Blob ID3DBlob;
 
-struct RenderPackage
-{
-	GraphicsComponent* m_graphicsComponent = nullptr;
-	SceneComponent* m_sceneComponent = nullptr;
-};
-
 namespace DirectX
 {
 	class ScratchImage;
@@ -66,11 +67,12 @@ public:
 	bool Initialize(INIReader* ini) override final;
 	void Update(float deltaTime) override final;
 	void Exit(void) override final;
+	const char* GetName(void) const override final;
 
 	void RegisterMessages(void) override final;
-	void ProcessMessage(const Message* message) override final;
 
 	void RegisterComponents(void) const override final;
+	void DeclareAccess(SystemAccess& access) const override final;
 
 	ID3D11Buffer* CreateConstantBuffer(UINT size, const void* data = nullptr) const;
 	template <typename Type>
@@ -89,6 +91,12 @@ public:
 	bool ResizeSwapChain(uint32_t width, uint32_t height);
 
 private:
+	void OnWindowResize(const WindowResizeMessage& msg);
+	void OnMaterialRequest(const MaterialRequestMessage& msg);
+	void OnModelRequest(const ModelRequestMessage& msg);
+	void OnAssignTextureToMaterial(const AssignTextureToMaterialMessage& msg);
+	void OnAssignMeshToModel(const AssignMeshToModelMessage& msg);
+
 	void ReadTextureData(const std::string& filePath);
 	void ReadMaterialData(const std::string& filePath);
 	void ReadModelData(const std::string& filePath);
@@ -123,9 +131,7 @@ private:
 	std::map<std::string, ID3D11PixelShader*> m_pixelShaders;
 	std::map<std::string, ID3DBlob*> m_vertexShaderBlobs;
 	std::map<std::string, ID3D11Buffer*> m_constantBuffers;
-	std::vector<RenderPackage> m_renderPackages;
-
-	std::vector<GraphicsComponent*> m_graphicsComponents; // stores graphics components for Update. Repopulates every frame.
+	RenderList m_renderList;
 
 	WorldManager* m_worldManager; // used for getting the Camera pointer from the currently active world
 };
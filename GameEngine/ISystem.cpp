@@ -22,4 +22,30 @@ ISystem::ISystem(App* app, GameObjectFactory* GOF)
 	, m_appPtr(app)
 	, m_GOF(GOF)
 	, m_iniReader(nullptr)
-{}
\ No newline at end of file
+{}
+
+static bool ContainsAny(const std::vector<std::string>& names, const std::vector<std::string>& other)
+{
+	for (const std::string& name : names)
+	{
+		for (const std::string& otherName : other)
+		{
+			if (name == otherName)
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+bool SystemAccess::ConflictsWith(const SystemAccess& other) const
+{
+	if (m_writesAll || other.m_writesAll)
+	{
+		return true;
+	}
+
+	return ContainsAny(m_writes, other.m_writes) || ContainsAny(m_writes, other.m_reads) || ContainsAny(m_reads, other.m_writes);
+}
@@ -18,10 +18,25 @@
 
 #include "ThirdParty/INIReader/cpp/INIReader.h"
 #include "Subscriber.h"
+#include <string>
+#include <vector>
 
 class App;
 class GameObjectFactory;
 
+/* SystemAccess - data a system touches during Update. Names are component type names or names of
+shared resources. Systems with no conflicting access run at the same time on the job system */
+struct SystemAccess
+{
+	std::vector<std::string> m_reads;
+	std::vector<std::string> m_writes;
+	bool m_writesAll = true;	// access is unknown, conflicts with every other system
+	bool m_mainThread = true;	// Update has to run on the main thread (window, D3D11 context, ImGui)
+	bool m_simulation = false;	// Update runs on the fixed simulation tick, otherwise once per rendered frame
+
+	bool ConflictsWith(const SystemAccess& other) const;
+};
+
 class ISystem : public Subscriber
 {
 public:
@@ -31,9 +46,17 @@ public:
 
 	virtual bool Initialize(INIReader* ini) = 0;
 	virtual void Update(float deltaTime) = 0;
+	// UpdateUI: called on the main thread once per rendered frame before simulation ticks. Simulation systems
+	// build their ImGui windows here, a frame can run any number of ticks
+	virtual void UpdateUI(float deltaTime) {}
 	virtual void Exit(void) = 0;
+	// GetName: readable name for profiler scopes, hitch reports and the schedule window, has to outlive the system
+	virtual const char* GetName(void) const = 0;
 
 	virtual void RegisterComponents(void) const {}
+	/* DeclareAccess: called every frame before scheduling with the access of the last call, waves are only rebuilt when it changes.
+	Lists keep their names between calls, so they only need filling once. Default access runs the system alone on the main thread */
+	virtual void DeclareAccess(SystemAccess& access) const {}
 
 	const INIReader* m_iniReader;
 
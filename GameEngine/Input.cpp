@@ -17,23 +17,136 @@
 #include "App.h"
 #include "Messenger.h"
 #include "MessagesInput.h"
+
+#if PLATFORM_WIN32
 #include <windowsx.h>
+#endif
 
 Input::Input(App* app)
 	: m_messenger(app->GetMessenger())
+#if PLATFORM_WIN32
+	, m_events{}
+	, m_firstEvent(0U)
+	, m_numEvents(0U)
+#endif
 	, m_currentKeyState{}
 	, m_previousKeyState{}
+	, m_pressedKeys{}
 	, m_currentMouseCoordinates{}
 	, m_previousMouseCoordinates{}
 	, m_deltaMouseWheel(0)
-	, m_isInputMessageCreated(false)
 {}
 
 Input::~Input(void)
 {}
 
+#if PLATFORM_WIN32
 int Input::ProcessInput(UINT uMsg, WPARAM wParam, LPARAM lParam)
 {
+	if (m_numEvents == MAX_EVENTS)
+	{
+		ApplyEvent(m_events[m_firstEvent]);
+		m_firstEvent = (m_firstEvent + 1U) % MAX_EVENTS;
+		--m_numEvents;
+	}
+
+	m_events[(m_firstEvent + m_numEvents) % MAX_EVENTS] = { uMsg, wParam, lParam };
+	++m_numEvents;
+
+	return 0;
+}
+#endif
+
+void Input::Reset(void)
+{
+	m_currentKeyState = {};
+	m_previousKeyState = {};
+	m_pressedKeys = {};
+#if PLATFORM_WIN32
+	m_firstEvent = 0U;
+	m_numEvents = 0U;
+#endif
+}
+
+float Input::Finalize(float deltaTime)
+{
+	InputSnapshot snapshot = {};
+	if (m_recorder.Next(snapshot))
+	{
+#if PLATFORM_WIN32
+		m_firstEvent = 0U;
+		m_numEvents = 0U;
+#endif
+		m_currentKeyState = snapshot.m_keys;
+		m_pressedKeys = {};
+		m_currentMouseCoordinates = snapshot.m_mouseCoordinates;
+		m_deltaMouseWheel = snapshot.m_deltaMouseWheel;
+
+		CreateInputMessage(snapshot.m_keys);
+		UpdateInputState(snapshot.m_keys);
+		return snapshot.m_deltaTime;
+	}
+
+#if PLATFORM_WIN32
+	ApplyEvents();
+#endif
+
+	/* Keys pressed and released within the frame are reported down for this frame */
+	KeyStates frameKeyState = m_currentKeyState;
+	for (uint32_t i = 0U; i < KeyStates::NUM_WORDS; ++i)
+	{
+		frameKeyState.m_words[i] |= m_pressedKeys.m_words[i];
+	}
+
+	m_recorder.Record({ frameKeyState, m_currentMouseCoordinates, m_deltaMouseWheel, deltaTime });
+
+	CreateInputMessage(frameKeyState);
+	UpdateInputState(frameKeyState);
+	return deltaTime;
+}
+
+InputRecorder& Input::GetRecorder(void)
+{
+	return m_recorder;
+}
+
+const KeyStates& Input::GetFrameKeyState(void) const
+{
+	return m_previousKeyState;
+}
+
+const MouseCoordinates& Input::GetFrameMouseCoordinates(void) const
+{
+	return m_previousMouseCoordinates;
+}
+
+#if PLATFORM_WIN32
+void Input::ApplyEvents(void)
+{
+	for (uint32_t i = 0U; i < m_numEvents; ++i)
+	{
+		ApplyEvent(m_events[(m_firstEvent + i) % MAX_EVENTS]);
+	}
+	m_firstEvent = 0U;
+	m_numEvents = 0U;
+
+	/* Special case: handle simultaneous left and right Shift presses/releases */
+	if (m_currentKeyState.IsDown(VK_LSHIFT) && !(GetKeyState(VK_LSHIFT) & 0x8000))
+	{
+		m_currentKeyState.Set(VK_LSHIFT, false);
+	}
+	if (m_currentKeyState.IsDown(VK_RSHIFT) && !(GetKeyState(VK_RSHIFT) & 0x8000))
+	{
+		m_currentKeyState.Set(VK_RSHIFT, false);
+	}
+}
+
+void Input::ApplyEvent(const InputEvent& inputEvent)
+{
+	UINT uMsg = inputEvent.m_message;
+	WPARAM wParam = inputEvent.m_wParam;
+	LPARAM lParam = inputEvent.m_lParam;
+
 	/* Special case: differentiating left/right Shift, Ctrl, Alt keys */
 	if (wParam == VK_SHIFT || wParam == VK_CONTROL || wParam == VK_MENU)
 	{
@@ -55,6 +168,7 @@ int Input::ProcessInput(UINT uMsg, WPARAM wParam, LPARAM lParam)
 		}
 	}
 
+	unsigned char key = static_cast<unsigned char>(wParam);
 	switch (uMsg)
 	{
 		/* Mouse movement */
@@ -65,7 +179,7 @@ int Input::ProcessInput(UINT uMsg, WPARAM wParam, LPARAM lParam)
 
 		/* Mouse wheel scrolling */
 	case WM_MOUSEWHEEL:
-		m_deltaMouseWheel = GET_WHEEL_DELTA_WPARAM(wParam) / WHEEL_DELTA;
+		m_deltaMouseWheel += GET_WHEEL_DELTA_WPARAM(wParam) / WHEEL_DELTA;
 		break;
 
 		/* Pressed keys */
@@ -75,81 +189,48 @@ int Input::ProcessInput(UINT uMsg, WPARAM wParam, LPARAM lParam)
 	case WM_RBUTTONDOWN:	// right mouse
 	case WM_MBUTTONDOWN:	// middle mouse
 	case WM_XBUTTONDOWN:	// additional mouse button
-		m_currentKeyState[wParam] = true;
+		/* Special case: left mouse double click */
+	case WM_LBUTTONDBLCLK:
+		m_currentKeyState.Set(key, true);
+		m_pressedKeys.Set(key, true);
 		break;
 
 		/* Released keyboard keys */
 	case WM_KEYUP:	// keyboard
 	case WM_SYSKEYUP:	// keyboard system key
-		m_currentKeyState[wParam] = false;
+		m_currentKeyState.Set(key, false);
 		break;
 
 		/* Released mouse keys - separate because Windows send wParam as 0 at release */
 	case WM_LBUTTONUP:	// left mouse
-		wParam = VK_LBUTTON;
-		m_currentKeyState[wParam] = false;
+		m_currentKeyState.Set(VK_LBUTTON, false);
 		break;
 	case WM_RBUTTONUP:	// right mouse
-		wParam = VK_RBUTTON;
-		m_currentKeyState[wParam] = false;
+		m_currentKeyState.Set(VK_RBUTTON, false);
 		break;
 	case WM_MBUTTONUP:	// middle mouse
-		wParam = VK_MBUTTON;
-		m_currentKeyState[wParam] = false;
+		m_currentKeyState.Set(VK_MBUTTON, false);
 		break;
 	case WM_XBUTTONUP:	// additional mouse button
 		/* Not tested - no compatible hardware */
-		m_currentKeyState[wParam] = false;
-		break;
-		/* Special case: left mouse double click */
-	case WM_LBUTTONDBLCLK:
-		m_currentKeyState[wParam] = true;
+		m_currentKeyState.Set(key, false);
 		break;
 	default:
 		break;
 	}
-
-	/* Special case: handle simultaneous left and right Shift presses/releases */
-	if (m_currentKeyState[VK_LSHIFT] && !(GetKeyState(VK_LSHIFT) & 0x8000))
-	{
-		m_currentKeyState[VK_LSHIFT] = false;
-	}
-	if (m_currentKeyState[VK_RSHIFT] && !(GetKeyState(VK_RSHIFT) & 0x8000))
-	{
-		m_currentKeyState[VK_RSHIFT] = false;
-	}
-
-	CreateInputMessage();
-	m_isInputMessageCreated = true;
-	UpdateInputState();
-
-	return 0;
-}
-
-void Input::Reset(void)
-{
-	memset(m_currentKeyState, 0, sizeof(bool) * kNumVirtualKeys);
-	memset(m_previousKeyState, 0, sizeof(bool) * kNumVirtualKeys);
-}
-
-void Input::Finalize(void)
-{
-	if (!m_isInputMessageCreated)
-	{
-		CreateInputMessage();
-	}
-	m_isInputMessageCreated = false;
 }
+#endif
 
-void Input::UpdateInputState(void)
+void Input::UpdateInputState(const KeyStates& frameKeyState)
 {
-	memcpy(m_previousKeyState, m_currentKeyState, sizeof(m_previousKeyState));
+	m_previousKeyState = frameKeyState;
+	m_pressedKeys = {};
 	m_previousMouseCoordinates = m_currentMouseCoordinates;
 	m_deltaMouseWheel = 0;
 }
 
-void Input::CreateInputMessage(void) const
+void Input::CreateInputMessage(const KeyStates& frameKeyState) const
 {
-	InputMessage msg(m_currentKeyState, m_previousKeyState, m_currentMouseCoordinates, m_previousMouseCoordinates, m_deltaMouseWheel);
+	InputMessage msg(frameKeyState, m_previousKeyState, m_currentMouseCoordinates, m_previousMouseCoordinates, m_deltaMouseWheel);
 	m_messenger.Send(msg);
 }
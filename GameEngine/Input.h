@@ -16,8 +16,8 @@
 #ifndef INPUT_H
 #define INPUT_H
 
-#include <Windows.h>
 #include "InputParameters.h"
+#include "InputRecorder.h"
 
 class App;
 class Messenger;
@@ -28,35 +28,63 @@ public:
 	Input(App* app);
 	~Input(void);
 
+#if PLATFORM_WIN32
+	// ProcessInput: stores the window event, events are applied in Finalize
 	int ProcessInput(UINT uMsg, WPARAM wParam, LPARAM lParam);
+#endif
 
 	void Reset(void);
 
-	/* Finalize - creates a dummy input update message without any changes,
-	used in frames without input events */
-	void Finalize(void);
+	/* Finalize - applies the frame's events and sends one InputMessage with the frame's input state.
+	Returns the delta time to simulate the frame with: deltaTime, or the recorded one while playing back */
+	float Finalize(float deltaTime);
+
+	InputRecorder& GetRecorder(void);
+
+	/* State of the last finalized frame */
+	const KeyStates& GetFrameKeyState(void) const;
+	const MouseCoordinates& GetFrameMouseCoordinates(void) const;
 
 private:
-	void UpdateInputState(void);	// update input states to prepare for the next input event
+#if PLATFORM_WIN32
+	struct InputEvent
+	{
+		UINT m_message;
+		WPARAM m_wParam;
+		LPARAM m_lParam;
+	};
 
-	void CreateInputMessage(void) const;
+	void ApplyEvents(void);	// applies the frame's window events in order
+	void ApplyEvent(const InputEvent& inputEvent);
+#endif
+	void UpdateInputState(const KeyStates& frameKeyState);	// update input states to prepare for the next frame
+
+	void CreateInputMessage(const KeyStates& frameKeyState) const;
 
 private:
 	Messenger& m_messenger;
 
-	/* Input states - track current and previous input states */
-	bool m_currentKeyState[kNumVirtualKeys];
-	bool m_previousKeyState[kNumVirtualKeys];
+#if PLATFORM_WIN32
+	/* Events of the current frame. When full, the oldest event is applied to make room */
+	static const uint32_t MAX_EVENTS = 64U;
+	InputEvent m_events[MAX_EVENTS];
+	uint32_t m_firstEvent;
+	uint32_t m_numEvents;
+#endif
+
+	/* Input states - track current key states and the states sent last frame */
+	KeyStates m_currentKeyState;
+	KeyStates m_previousKeyState;
+	KeyStates m_pressedKeys;	// keys pressed during the frame, a press and release within one frame still counts as down
 
 	/* Mouse coordinates - track current and previous mouse position */
 	MouseCoordinates m_previousMouseCoordinates;
 	MouseCoordinates m_currentMouseCoordinates;
 
-	/* Mouse wheel delta - track mouse wheel movement. Reset to 0 each frame */
+	/* Mouse wheel delta - wheel movement accumulated over the frame */
 	int m_deltaMouseWheel;
 
-	/* Checks if input message was created that frame. Reset every frame */
-	bool m_isInputMessageCreated;
+	InputRecorder m_recorder;	// while playing back, recorded frames replace window events
 };
 
 #endif
@@ -48,12 +48,12 @@ void InputComponent::RegisterCallback(std::function<void(const InputMessage*)>*
 
 void InputComponent::RegisterMessages(void)
 {
-	m_messenger.RegisterMessage<InputMessage>(this);
+	m_messenger.Subscribe<InputMessage>(this, &InputComponent::OnInput);
 }
 
-void InputComponent::ProcessMessage(const Message* message)
+void InputComponent::OnInput(const InputMessage& msg)
 {
-	m_ParentCallback(static_cast<const InputMessage*>(message));
+	m_ParentCallback(&msg);
 }
 
 void InputComponent::Deserialize(const JSONData& source)
@@ -34,7 +34,6 @@ public:
 	void RegisterCallback(std::function<void(const InputMessage*)>* CallbackFn);
 
 	void RegisterMessages(void) override;
-	void ProcessMessage(const Message* message) override;
 
 	void Deserialize(const JSONData & source) override;
 
@@ -43,6 +42,9 @@ public:
 	const std::string& GetObjectTypeName(void) const override;
 	static const std::string& GetClassTypeName(void);
 
+private:
+	void OnInput(const InputMessage& msg);
+
 private:
 	std::function<void(const InputMessage*)> m_ParentCallback;
 };
@@ -0,0 +1,164 @@
+// Copyright (C) 2023  Mantas Naujokas
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "InputRecorder.h"
+#include <iterator>
+#include <stdio.h>
+
+InputRecorder::InputRecorder(void)
+	: m_mode(Mode::None)
+	, m_nextSnapshot(0U)
+{}
+
+InputRecorder::~InputRecorder(void)
+{
+	Stop();
+}
+
+bool InputRecorder::StartRecording(const std::string& path)
+{
+	Stop();
+
+	m_file.open(path, std::ios::binary | std::ios::trunc);
+	if (!m_file.is_open())
+	{
+		fprintf(stderr, "InputRecorder::%s: cannot open \"%s\" for writing\n", __func__, path.c_str());
+		return false;
+	}
+
+	std::vector<uint8_t> header;
+	BinaryWriter writer(header);
+	writer.Write(FILE_MAGIC);
+	writer.Write(FILE_VERSION);
+	m_file.write(reinterpret_cast<const char*>(header.data()), header.size());
+
+	m_mode = Mode::Record;
+	return true;
+}
+
+bool InputRecorder::StartPlayback(const std::string& path)
+{
+	Stop();
+
+	std::ifstream file(path, std::ios::binary);
+	if (!file.is_open())
+	{
+		fprintf(stderr, "InputRecorder::%s: cannot open \"%s\"\n", __func__, path.c_str());
+		return false;
+	}
+	std::vector<uint8_t> buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	BinaryReader reader(buffer.data(), buffer.size());
+	uint32_t magic = 0U;
+	uint32_t version = 0U;
+	reader.Read(magic);
+	reader.Read(version);
+	if (!reader.IsValid() || magic != FILE_MAGIC || version != FILE_VERSION)
+	{
+		fprintf(stderr, "InputRecorder::%s: \"%s\" is not a version %u input recording\n", __func__, path.c_str(), FILE_VERSION);
+		return false;
+	}
+
+	InputSnapshot snapshot = {};
+	while (ReadSnapshot(reader, snapshot))
+	{
+		m_snapshots.push_back(snapshot);
+	}
+
+	m_nextSnapshot = 0U;
+	m_mode = Mode::Playback;
+	return true;
+}
+
+void InputRecorder::Stop(void)
+{
+	if (m_mode == Mode::Record)
+	{
+		m_file.close();
+	}
+	m_snapshots.clear();
+	m_nextSnapshot = 0U;
+	m_mode = Mode::None;
+}
+
+bool InputRecorder::IsRecording(void) const
+{
+	return m_mode == Mode::Record;
+}
+
+bool InputRecorder::IsPlaying(void) const
+{
+	return m_mode == Mode::Playback;
+}
+
+void InputRecorder::Record(const InputSnapshot& snapshot)
+{
+	if (m_mode == Mode::Record)
+	{
+		std::vector<uint8_t> buffer;
+		BinaryWriter writer(buffer);
+		WriteSnapshot(snapshot, writer);
+		m_file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+	}
+}
+
+bool InputRecorder::Next(InputSnapshot& snapshot)
+{
+	if (m_mode != Mode::Playback)
+	{
+		return false;
+	}
+
+	if (m_nextSnapshot == m_snapshots.size())
+	{
+		Stop();
+		return false;
+	}
+
+	snapshot = m_snapshots[m_nextSnapshot++];
+	return true;
+}
+
+void InputRecorder::WriteSnapshot(const InputSnapshot& snapshot, BinaryWriter& writer)
+{
+	for (uint64_t word : snapshot.m_keys.m_words)
+	{
+		writer.Write(word);
+	}
+	writer.Write(static_cast<int32_t>(snapshot.m_mouseCoordinates.x));
+	writer.Write(static_cast<int32_t>(snapshot.m_mouseCoordinates.y));
+	writer.Write(static_cast<int32_t>(snapshot.m_deltaMouseWheel));
+	writer.Write(snapshot.m_deltaTime);
+}
+
+bool InputRecorder::ReadSnapshot(BinaryReader& reader, InputSnapshot& snapshot)
+{
+	for (uint64_t& word : snapshot.m_keys.m_words)
+	{
+		reader.Read(word);
+	}
+
+	int32_t mouseX = 0;
+	int32_t mouseY = 0;
+	int32_t deltaMouseWheel = 0;
+	reader.Read(mouseX);
+	reader.Read(mouseY);
+	reader.Read(deltaMouseWheel);
+	reader.Read(snapshot.m_deltaTime);
+	snapshot.m_mouseCoordinates.x = mouseX;
+	snapshot.m_mouseCoordinates.y = mouseY;
+	snapshot.m_deltaMouseWheel = deltaMouseWheel;
+	return reader.IsValid();
+}
@@ -0,0 +1,75 @@
+// Copyright (C) 2023  Mantas Naujokas
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef INPUTRECORDER_H
+#define INPUTRECORDER_H
+
+#include "InputState.h"
+#include "BinaryStream.h"
+#include <fstream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/* InputSnapshot - input state of one frame as Input sends it, with the frame's delta time */
+struct InputSnapshot
+{
+	KeyStates m_keys;
+	MouseCoordinates m_mouseCoordinates;
+	int m_deltaMouseWheel;
+	float m_deltaTime;	// seconds
+};
+
+/* InputRecorder - writes a snapshot per frame while recording, hands them back in order while playing back.
+Platform independent, so sessions recorded on Windows play back in headless runs */
+class InputRecorder
+{
+public:
+	InputRecorder(void);
+	~InputRecorder(void);
+
+	bool StartRecording(const std::string& path);
+	bool StartPlayback(const std::string& path);
+	void Stop(void);
+
+	bool IsRecording(void) const;
+	bool IsPlaying(void) const;
+
+	void Record(const InputSnapshot& snapshot);
+	// Next: false and playback stops when the recording has no more frames
+	bool Next(InputSnapshot& snapshot);
+
+	static constexpr uint32_t FILE_MAGIC = 0x43455249U;	// "IREC"
+	static constexpr uint32_t FILE_VERSION = 1U;	// increase when WriteSnapshot/ReadSnapshot change
+
+private:
+	/* Snapshots are written field by field with fixed size types, so the file does not depend on struct padding or int size */
+	static void WriteSnapshot(const InputSnapshot& snapshot, BinaryWriter& writer);
+	static bool ReadSnapshot(BinaryReader& reader, InputSnapshot& snapshot);
+
+private:
+	enum class Mode
+	{
+		None,
+		Record,
+		Playback
+	} m_mode;
+
+	std::ofstream m_file;
+	std::vector<InputSnapshot> m_snapshots;	// playback frames
+	size_t m_nextSnapshot;
+};
+
+#endif
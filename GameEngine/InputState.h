@@ -0,0 +1,58 @@
+// Copyright (C) 2023  Mantas Naujokas
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef INPUTSTATE_H
+#define INPUTSTATE_H
+
+#include <stdint.h>
+
+/* Platform independent input state, shared by Input, InputMessage and InputRecorder */
+
+struct MouseCoordinates
+{
+	int x;
+	int y;
+
+	MouseCoordinates operator-(const MouseCoordinates& rhs) const
+	{
+		return MouseCoordinates{ x - rhs.x, y - rhs.y };
+	}
+};
+
+/* Number of keys supported on standard mouse and keyboard */
+enum
+{
+	kNumVirtualKeys = (unsigned char)~0
+};
+
+/* KeyStates - one bit per virtual key, bit set while the key is down */
+struct KeyStates
+{
+	static const uint32_t NUM_WORDS = 4U;	// 256 bits, covers every unsigned char key value
+	uint64_t m_words[NUM_WORDS];
+
+	bool IsDown(unsigned char key) const
+	{
+		return ((m_words[key >> 6U] >> (key & 63U)) & 1U) != 0U;
+	}
+
+	void Set(unsigned char key, bool isDown)
+	{
+		uint64_t bit = 1ULL << (key & 63U);
+		m_words[key >> 6U] = isDown ? (m_words[key >> 6U] | bit) : (m_words[key >> 6U] & ~bit);
+	}
+};
+
+#endif
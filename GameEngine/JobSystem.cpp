@@ -0,0 +1,345 @@
+// Copyright (C) 2023  Mantas Naujokas
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "JobSystem.h"
+#include "Profiler.h"
+#include <cstdio>
+
+static thread_local uint32_t tThreadIndex = 0U;
+static thread_local bool tIsJobThread = false;
+static thread_local void* tJobLocals[static_cast<size_t>(JobSystem::JobLocal::Count)] = {};
+
+JobCounter::JobCounter(void)
+	: m_count(0U)
+{}
+
+bool JobCounter::IsDone(void) const
+{
+	return m_count.load(std::memory_order_acquire) == 0U;
+}
+
+JobSystem::JobSystem(void)
+	: m_running(false)
+	, m_numQueuedJobs(0U)
+{
+	tIsJobThread = true;	// the creating thread is the main thread
+	m_queues.push_back(new JobQueue);	// main thread's queue
+}
+
+JobSystem::~JobSystem(void)
+{
+	Shutdown();
+
+	for (JobQueue* queue : m_queues)
+	{
+		delete queue;
+	}
+}
+
+void JobSystem::Initialize(int numWorkers)
+{
+	if (m_running)
+	{
+		fprintf(stderr, "JobSystem::%s: job system is already running\n", __func__);
+		return;
+	}
+
+	if (numWorkers < 0)
+	{
+		int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+		numWorkers = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+	}
+
+	m_running = true;
+	for (int i = 0; i < numWorkers; ++i)
+	{
+		m_queues.push_back(new JobQueue);
+	}
+	for (int i = 0; i < numWorkers; ++i)
+	{
+		uint32_t threadIndex = static_cast<uint32_t>(i) + 1U;
+		m_workers.push_back(std::thread(&JobSystem::WorkerLoop, this, threadIndex));
+	}
+}
+
+void JobSystem::Shutdown(void)
+{
+	if (!m_running)
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_wakeMutex);
+		m_running = false;
+	}
+	m_wakeCondition.notify_all();
+
+	for (std::thread& worker : m_workers)
+	{
+		worker.join();
+	}
+	m_workers.clear();
+
+	/* Finish what is left on the calling thread */
+	while (TryRunJob(0U) || TryRunMainThreadJob())
+	{}
+
+	while (m_queues.size() > 1U)
+	{
+		delete m_queues.back();
+		m_queues.pop_back();
+	}
+}
+
+void JobSystem::Schedule(const JobFunction& job, JobCounter* counter, const JobCounter* dependency)
+{
+	if (counter != nullptr)
+	{
+		counter->m_count.fetch_add(1U, std::memory_order_relaxed);
+	}
+
+	Job newJob = { job, counter, dependency };
+	uint32_t threadIndex = tThreadIndex < m_queues.size() ? tThreadIndex : 0U;
+	if (dependency != nullptr)
+	{ // queued jobs wake workers, so jobs that cannot run yet wait outside the queues
+		std::lock_guard<std::mutex> lock(m_waitingMutex);
+		if (!dependency->IsDone())
+		{
+			WaitingJob waiting = { std::move(newJob), threadIndex };
+			m_waitingJobs.push_back(std::move(waiting));
+			return;
+		}
+	}
+	Push(*m_queues[threadIndex], newJob);
+}
+
+void JobSystem::ScheduleOnMainThread(const JobFunction& job, JobCounter* counter, const JobCounter* dependency)
+{
+	if (counter != nullptr)
+	{
+		counter->m_count.fetch_add(1U, std::memory_order_relaxed);
+	}
+
+	Job newJob = { job, counter, dependency };
+	std::lock_guard<std::mutex> lock(m_mainThreadQueue.m_mutex);
+	m_mainThreadQueue.m_jobs.push_back(std::move(newJob));
+}
+
+void JobSystem::ParallelFor(size_t count, size_t grainSize, const RangeFunction& fn)
+{
+	if (grainSize == 0U)
+	{
+		grainSize = 1U;
+	}
+
+	if (m_workers.empty() || count <= grainSize)
+	{
+		fn(0U, count);
+		return;
+	}
+
+	JobCounter counter;
+	for (size_t begin = grainSize; begin < count; begin += grainSize)
+	{
+		size_t end = begin + grainSize < count ? begin + grainSize : count;
+		Schedule([&fn, begin, end]() { fn(begin, end); }, &counter);
+	}
+
+	fn(0U, grainSize);	// first range on the calling thread
+	Wait(counter);
+}
+
+void JobSystem::Wait(const JobCounter& counter)
+{
+	uint32_t threadIndex = tThreadIndex < m_queues.size() ? tThreadIndex : 0U;
+
+	while (!counter.IsDone())
+	{
+		bool hasRun = TryRunJob(threadIndex);
+		if (!hasRun && threadIndex == 0U)
+		{
+			hasRun = TryRunMainThreadJob();
+		}
+		if (!hasRun)
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void JobSystem::RunMainThreadJobs(void)
+{
+	while (TryRunMainThreadJob())
+	{}
+}
+
+uint32_t JobSystem::GetNumWorkers(void) const
+{
+	return static_cast<uint32_t>(m_workers.size());
+}
+
+uint32_t JobSystem::GetThreadIndex(void)
+{
+	return tThreadIndex;
+}
+
+bool JobSystem::IsJobThread(void)
+{
+	return tIsJobThread;
+}
+
+void* JobSystem::GetJobLocal(JobLocal local)
+{
+	return tJobLocals[static_cast<size_t>(local)];
+}
+
+void* JobSystem::SetJobLocal(JobLocal local, void* value)
+{
+	void* previous = tJobLocals[static_cast<size_t>(local)];
+	tJobLocals[static_cast<size_t>(local)] = value;
+	return previous;
+}
+
+void JobSystem::WorkerLoop(uint32_t threadIndex)
+{
+	tThreadIndex = threadIndex;
+	tIsJobThread = true;
+
+	while (m_running)
+	{
+		if (TryRunJob(threadIndex))
+		{
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_wakeMutex);
+		m_wakeCondition.wait(lock, [this]() { return !m_running || m_numQueuedJobs.load() > 0U; });
+	}
+}
+
+void JobSystem::Push(JobQueue& queue, Job& job)
+{
+	{
+		std::lock_guard<std::mutex> lock(queue.m_mutex);
+		queue.m_jobs.push_back(std::move(job));
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_wakeMutex);
+		m_numQueuedJobs.fetch_add(1U);
+	}
+	m_wakeCondition.notify_one();
+}
+
+bool JobSystem::TryRunJob(uint32_t threadIndex)
+{
+	Job job;
+
+	/* Own queue newest first, keeps data the thread just worked on in cache */
+	bool found = PopReady(*m_queues[threadIndex], true, job);
+
+	/* Steal oldest jobs from other threads */
+	size_t numQueues = m_queues.size();
+	for (size_t i = 1U; !found && i < numQueues; ++i)
+	{
+		found = PopReady(*m_queues[(threadIndex + i) % numQueues], false, job);
+	}
+
+	if (!found)
+	{
+		return false;
+	}
+
+	m_numQueuedJobs.fetch_sub(1U);
+	Execute(job);
+	return true;
+}
+
+bool JobSystem::TryRunMainThreadJob(void)
+{
+	Job job;
+	if (!PopReady(m_mainThreadQueue, false, job))
+	{
+		return false;
+	}
+
+	Execute(job);
+	return true;
+}
+
+bool JobSystem::PopReady(JobQueue& queue, bool fromBack, Job& job)
+{
+	std::lock_guard<std::mutex> lock(queue.m_mutex);
+	size_t numJobs = queue.m_jobs.size();
+
+	for (size_t i = 0U; i < numJobs; ++i)
+	{
+		size_t index = fromBack ? numJobs - 1U - i : i;
+		const JobCounter* dependency = queue.m_jobs[index].m_dependency;
+		if (dependency == nullptr || dependency->IsDone())
+		{
+			job = std::move(queue.m_jobs[index]);
+			queue.m_jobs.erase(queue.m_jobs.begin() + index);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void JobSystem::Execute(Job& job)
+{
+	void* waitingLocals[static_cast<size_t>(JobLocal::Count)];
+	for (size_t i = 0U; i < static_cast<size_t>(JobLocal::Count); ++i)
+	{
+		waitingLocals[i] = tJobLocals[i];
+		tJobLocals[i] = nullptr;
+	}
+
+	{
+		PROFILE_SCOPE("JobSystem::Execute");
+		job.m_function();
+	}
+
+	for (size_t i = 0U; i < static_cast<size_t>(JobLocal::Count); ++i)
+	{
+		tJobLocals[i] = waitingLocals[i];
+	}
+
+	if (job.m_counter != nullptr && job.m_counter->m_count.fetch_sub(1U, std::memory_order_acq_rel) == 1U)
+	{
+		QueueReleasedJobs();
+	}
+}
+
+void JobSystem::QueueReleasedJobs(void)
+{
+	std::lock_guard<std::mutex> lock(m_waitingMutex);
+	for (size_t i = 0U; i < m_waitingJobs.size();)
+	{
+		WaitingJob& waiting = m_waitingJobs[i];
+		if (waiting.m_job.m_dependency->IsDone())
+		{
+			uint32_t queueIndex = waiting.m_queueIndex < m_queues.size() ? waiting.m_queueIndex : 0U;	// worker queues are gone after Shutdown
+			Push(*m_queues[queueIndex], waiting.m_job);
+			m_waitingJobs.erase(m_waitingJobs.begin() + i);
+		}
+		else
+		{
+			++i;
+		}
+	}
+}
@@ -0,0 +1,131 @@
+// Copyright (C) 2023  Mantas Naujokas
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* JobCounter - number of unfinished jobs, reaches zero when all jobs it was passed to are done */
+class JobCounter
+{
+public:
+	friend class JobSystem;
+
+	JobCounter(void);
+	JobCounter(const JobCounter& rhs) = delete;
+
+	bool IsDone(void) const;
+
+private:
+	std::atomic<uint32_t> m_count;
+};
+
+/* JobSystem - pool of worker threads. Every thread has its own job queue, idle workers
+steal jobs from other queues. Threads waiting for a counter run jobs in the meantime */
+class JobSystem
+{
+public:
+	typedef std::function<void(void)> JobFunction;
+	typedef std::function<void(size_t, size_t)> RangeFunction;
+
+	JobSystem(void);
+	~JobSystem(void);
+	JobSystem(const JobSystem& rhs) = delete;
+
+	// Initialize: starts worker threads. Negative numWorkers uses one less than hardware threads,
+	// with 0 workers all jobs run on the main thread while it waits
+	void Initialize(int numWorkers);
+	void Shutdown(void);
+
+	// Schedule: counter (optional) is decremented when job finishes, job does not start until dependency is done
+	void Schedule(const JobFunction& job, JobCounter* counter = nullptr, const JobCounter* dependency = nullptr);
+	// ScheduleOnMainThread: job runs on the main thread in RunMainThreadJobs or while main thread waits
+	void ScheduleOnMainThread(const JobFunction& job, JobCounter* counter = nullptr, const JobCounter* dependency = nullptr);
+
+	// ParallelFor: calls fn(begin, end) for ranges of at most grainSize items, returns when all ranges are done
+	void ParallelFor(size_t count, size_t grainSize, const RangeFunction& fn);
+
+	// Wait: runs other jobs until counter is done
+	void Wait(const JobCounter& counter);
+
+	void RunMainThreadJobs(void);
+
+	uint32_t GetNumWorkers(void) const;
+	// GetThreadIndex: 0 for the main thread, 1 to GetNumWorkers() for workers
+	static uint32_t GetThreadIndex(void);
+	// IsJobThread: true for the thread that created the job system and its workers, other threads also get index 0
+	static bool IsJobThread(void);
+
+	/* Job locals - per thread bindings that belong to the running job, e.g. the outbox its messages go to.
+	Every job starts with them cleared and the thread's values come back when it ends, so a job
+	run by a thread that waits does not record into the waiting job's outbox */
+	enum class JobLocal
+	{
+		Outbox,
+		CommandBuffer,
+		Count
+	};
+	static void* GetJobLocal(JobLocal local);
+	static void* SetJobLocal(JobLocal local, void* value);	// returns the previous value
+
+private:
+	struct Job
+	{
+		JobFunction m_function;
+		JobCounter* m_counter;
+		const JobCounter* m_dependency;
+	};
+
+	struct JobQueue
+	{
+		std::mutex m_mutex;
+		std::deque<Job> m_jobs;
+	};
+
+	struct WaitingJob
+	{
+		Job m_job;
+		uint32_t m_queueIndex;	// queue of the scheduling thread, the job goes there once its dependency is done
+	};
+
+	void WorkerLoop(uint32_t threadIndex);
+	void Push(JobQueue& queue, Job& job);
+	bool TryRunJob(uint32_t threadIndex);	// runs one job from own queue or steals one, false if none was run
+	bool TryRunMainThreadJob(void);
+	bool PopReady(JobQueue& queue, bool fromBack, Job& job);
+	void Execute(Job& job);
+	void QueueReleasedJobs(void);	// moves waiting jobs whose dependency is done to their queues
+
+private:
+	std::vector<std::thread> m_workers;
+	std::vector<JobQueue*> m_queues;	// one per thread, main thread's queue first
+	JobQueue m_mainThreadQueue;	// jobs that have to run on the main thread
+
+	std::atomic<bool> m_running;
+	std::atomic<uint32_t> m_numQueuedJobs;	// jobs in m_queues, all of them can run
+	std::vector<WaitingJob> m_waitingJobs;	// scheduled jobs whose dependency is not done yet
+	std::mutex m_waitingMutex;
+	std::mutex m_wakeMutex;
+	std::condition_variable m_wakeCondition;
+};
+
+#endif
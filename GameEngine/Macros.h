@@ -23,4 +23,8 @@
 #define STR_INTERNAL(x) #x
 #define STR(x) STR_INTERNAL(x)
 
+// Concatenate after expanding
+#define CONCAT_INTERNAL(a, b) a##b
+#define CONCAT(a, b) CONCAT_INTERNAL(a, b)
+
 #endif
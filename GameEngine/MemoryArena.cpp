@@ -0,0 +1,167 @@
+// Copyright (C) 2023  Mantas Naujokas
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "MemoryArena.h"
+#include <algorithm>
+
+MemoryArena::MemoryArena(size_t chunkSize)
+	: m_chunkSize(chunkSize > 0U ? chunkSize : DEFAULT_CHUNK_SIZE)
+	, m_currentChunk(0U)
+	, m_offset(0U)
+	, m_releasing(false)
+	, m_capacity(0U)
+	, m_used(0U)
+	, m_peakUsed(0U)
+{}
+
+MemoryArena::~MemoryArena(void)
+{
+	for (Chunk& chunk : m_chunks)
+	{
+		delete[] chunk.m_data;
+	}
+}
+
+void* MemoryArena::Allocate(size_t size)
+{
+	// Block has to be able to hold a free list node, round up to alignment
+	if (size < sizeof(FreeBlock))
+	{
+		size = sizeof(FreeBlock);
+	}
+	size_t blockSize = (size + BLOCK_ALIGNMENT - 1U) & ~(BLOCK_ALIGNMENT - 1U);
+	size_t listIndex = blockSize / BLOCK_ALIGNMENT;
+
+	void* block = nullptr;
+	if (listIndex < m_freeLists.size() && m_freeLists[listIndex] != nullptr)
+	{
+		FreeBlock* freeBlock = m_freeLists[listIndex];
+		m_freeLists[listIndex] = freeBlock->m_next;
+		block = freeBlock;
+	}
+	else
+	{
+		block = AllocateFromChunk(blockSize);
+	}
+
+	m_used += blockSize;
+	if (m_used > m_peakUsed)
+	{
+		m_peakUsed = m_used;
+	}
+
+	return block;
+}
+
+void MemoryArena::Free(void* block, size_t size)
+{
+	if (block == nullptr || m_releasing)
+	{
+		return;
+	}
+
+	if (size < sizeof(FreeBlock))
+	{
+		size = sizeof(FreeBlock);
+	}
+	size_t blockSize = (size + BLOCK_ALIGNMENT - 1U) & ~(BLOCK_ALIGNMENT - 1U);
+	size_t listIndex = blockSize / BLOCK_ALIGNMENT;
+	if (listIndex >= m_freeLists.size())
+	{
+		m_freeLists.resize(listIndex + 1U, nullptr);
+	}
+
+	FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+	freeBlock->m_next = m_freeLists[listIndex];
+	m_freeLists[listIndex] = freeBlock;
+	m_used -= blockSize;
+}
+
+void MemoryArena::Reserve(size_t numBytes)
+{
+	size_t available = 0U;
+	if (m_currentChunk < m_chunks.size())
+	{
+		available = m_chunks[m_currentChunk].m_size - m_offset;
+		for (size_t i = m_currentChunk + 1U; i < m_chunks.size(); ++i)
+		{
+			available += m_chunks[i].m_size;
+		}
+	}
+
+	if (numBytes > available)
+	{
+		size_t chunkSize = std::max(m_chunkSize, numBytes - available);
+		m_chunks.push_back({ new char[chunkSize], chunkSize });
+		m_capacity += chunkSize;
+	}
+}
+
+void MemoryArena::BeginRelease(void)
+{
+	m_releasing = true;
+}
+
+void MemoryArena::Release(void)
+{
+	std::fill(m_freeLists.begin(), m_freeLists.end(), nullptr);
+	m_currentChunk = 0U;
+	m_offset = 0U;
+	m_used = 0U;
+	m_releasing = false;
+}
+
+size_t MemoryArena::GetUsedBytes(void) const
+{
+	return m_used;
+}
+
+size_t MemoryArena::GetPeakUsedBytes(void) const
+{
+	return m_peakUsed;
+}
+
+size_t MemoryArena::GetCapacity(void) const
+{
+	return m_capacity;
+}
+
+size_t MemoryArena::GetNumChunks(void) const
+{
+	return m_chunks.size();
+}
+
+void* MemoryArena::AllocateFromChunk(size_t blockSize)
+{
+	/* Move on to the next chunk that fits the block, remaining space of skipped chunks stays unused */
+	while (m_currentChunk < m_chunks.size() && m_offset + blockSize > m_chunks[m_currentChunk].m_size)
+	{
+		++m_currentChunk;
+		m_offset = 0U;
+	}
+
+	if (m_currentChunk == m_chunks.size())
+	{
+		// new[] storage is aligned for any fundamental type, blocks keep BLOCK_ALIGNMENT from there
+		size_t chunkSize = std::max(m_chunkSize, blockSize);
+		m_chunks.push_back({ new char[chunkSize], chunkSize });
+		m_capacity += chunkSize;
+		m_offset = 0U;
+	}
+
+	void* block = m_chunks[m_currentChunk].m_data + m_offset;
+	m_offset += blockSize;
+	return block;
+}
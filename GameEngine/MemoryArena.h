@@ -0,0 +1,82 @@
+// Copyright (C) 2023  Mantas Naujokas
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef MEMORYARENA_H
+#define MEMORYARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/* MemoryArena - allocates blocks of any size by bumping through large chunks. Freed blocks are
+kept in per-size free lists and reused. Release drops every allocation at once, chunks are kept
+for the next use of the arena */
+class MemoryArena
+{
+public:
+	MemoryArena(size_t chunkSize = DEFAULT_CHUNK_SIZE);
+	~MemoryArena(void);
+	MemoryArena(const MemoryArena& rhs) = delete;
+	MemoryArena& operator=(const MemoryArena& rhs) = delete;
+
+	void* Allocate(size_t size);
+	void Free(void* block, size_t size);
+
+	// Reserve: adds a chunk up front if numBytes would not fit in the remaining chunks
+	void Reserve(size_t numBytes);
+
+	// BeginRelease: Free calls are ignored until Release. Used while destroying the arena's contents
+	void BeginRelease(void);
+	// Release: invalidates every block allocated from the arena in one step
+	void Release(void);
+
+	size_t GetUsedBytes(void) const;
+	size_t GetPeakUsedBytes(void) const;
+	size_t GetCapacity(void) const;	// total size of all chunks in bytes
+	size_t GetNumChunks(void) const;
+
+public:
+	static const size_t DEFAULT_CHUNK_SIZE = 64U * 1024U;
+	static const size_t BLOCK_ALIGNMENT = 16U;
+
+private:
+	void* AllocateFromChunk(size_t blockSize);
+
+private:
+	struct FreeBlock
+	{
+		FreeBlock* m_next;
+	};
+
+	struct Chunk
+	{
+		char* m_data;
+		size_t m_size;
+	};
+
+	size_t m_chunkSize;
+	std::vector<Chunk> m_chunks;
+	size_t m_currentChunk;	// index of the chunk blocks are currently taken from
+	size_t m_offset;	// first unused byte in the current chunk
+
+	std::vector<FreeBlock*> m_freeLists;	// free lists indexed by block size / BLOCK_ALIGNMENT
+	bool m_releasing;
+
+	size_t m_capacity;
+	size_t m_used;
+	size_t m_peakUsed;
+};
+
+#endif
@@ -0,0 +1,123 @@
+// Copyright (C) 2023  Mantas Naujokas
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "MemoryPool.h"
+
+MemoryPool::MemoryPool(size_t blockSize, size_t blocksPerChunk)
+	: m_blockSize(0U)
+	, m_blocksPerChunk(blocksPerChunk > 0U ? blocksPerChunk : DEFAULT_BLOCKS_PER_CHUNK)
+	, m_freeList(nullptr)
+	, m_capacity(0U)
+	, m_numUsed(0U)
+	, m_peakUsed(0U)
+{
+	// Block has to be able to hold a free list node, round up to alignment
+	if (blockSize < sizeof(FreeBlock))
+	{
+		blockSize = sizeof(FreeBlock);
+	}
+	m_blockSize = (blockSize + BLOCK_ALIGNMENT - 1U) & ~(BLOCK_ALIGNMENT - 1U);
+}
+
+MemoryPool::~MemoryPool(void)
+{
+	for (char* chunk : m_chunks)
+	{
+		delete[] chunk;
+	}
+}
+
+void* MemoryPool::Allocate(void)
+{
+	if (m_freeList == nullptr)
+	{
+		AllocateChunk(m_blocksPerChunk);
+	}
+
+	FreeBlock* block = m_freeList;
+	m_freeList = block->m_next;
+
+	++m_numUsed;
+	if (m_numUsed > m_peakUsed)
+	{
+		m_peakUsed = m_numUsed;
+	}
+
+	return block;
+}
+
+void MemoryPool::Free(void* block)
+{
+	if (block == nullptr)
+	{
+		return;
+	}
+
+	FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+	freeBlock->m_next = m_freeList;
+	m_freeList = freeBlock;
+	--m_numUsed;
+}
+
+void MemoryPool::Reserve(size_t numBlocks)
+{
+	size_t available = m_capacity - m_numUsed;
+	if (numBlocks > available)
+	{
+		AllocateChunk(numBlocks - available);
+	}
+}
+
+size_t MemoryPool::GetBlockSize(void) const
+{
+	return m_blockSize;
+}
+
+size_t MemoryPool::GetCapacity(void) const
+{
+	return m_capacity;
+}
+
+size_t MemoryPool::GetNumUsedBlocks(void) const
+{
+	return m_numUsed;
+}
+
+size_t MemoryPool::GetPeakUsedBlocks(void) const
+{
+	return m_peakUsed;
+}
+
+size_t MemoryPool::GetNumChunks(void) const
+{
+	return m_chunks.size();
+}
+
+void MemoryPool::AllocateChunk(size_t numBlocks)
+{
+	// new[] storage is aligned for any fundamental type, blocks keep BLOCK_ALIGNMENT from there
+	char* chunk = new char[m_blockSize * numBlocks];
+	m_chunks.push_back(chunk);
+
+	/* Push blocks in reverse order so allocations walk the chunk front to back */
+	for (size_t i = numBlocks; i > 0U; --i)
+	{
+		FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + (i - 1U) * m_blockSize);
+		block->m_next = m_freeList;
+		m_freeList = block;
+	}
+
+	m_capacity += numBlocks;
+}
@@ -0,0 +1,69 @@
+// Copyright (C) 2023  Mantas Naujokas
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef MEMORYPOOL_H
+#define MEMORYPOOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/* MemoryPool - fixed-size block allocator. Freed blocks are kept in a free list and reused
+by the next allocation, storage is only returned to the system when the pool is destroyed */
+class MemoryPool
+{
+public:
+	MemoryPool(size_t blockSize, size_t blocksPerChunk = DEFAULT_BLOCKS_PER_CHUNK);
+	~MemoryPool(void);
+	MemoryPool(const MemoryPool& rhs) = delete;
+	MemoryPool& operator=(const MemoryPool& rhs) = delete;
+
+	void* Allocate(void);
+	void Free(void* block);
+
+	// Reserve: makes sure at least numBlocks blocks can be allocated without growing the pool
+	void Reserve(size_t numBlocks);
+
+	size_t GetBlockSize(void) const;
+	size_t GetCapacity(void) const;	// total number of blocks
+	size_t GetNumUsedBlocks(void) const;
+	size_t GetPeakUsedBlocks(void) const;
+	size_t GetNumChunks(void) const;
+
+public:
+	static const size_t DEFAULT_BLOCKS_PER_CHUNK = 64U;
+	static const size_t BLOCK_ALIGNMENT = 16U;
+
+private:
+	void AllocateChunk(size_t numBlocks);
+
+private:
+	struct FreeBlock
+	{
+		FreeBlock* m_next;
+	};
+
+	size_t m_blockSize;
+	size_t m_blocksPerChunk;
+
+	std::vector<char*> m_chunks;
+	FreeBlock* m_freeList;
+
+	size_t m_capacity;
+	size_t m_numUsed;
+	size_t m_peakUsed;
+};
+
+#endif
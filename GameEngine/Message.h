@@ -16,6 +16,7 @@
 #ifndef MESSAGE_H
 #define MESSAGE_H
 
+#include <stddef.h>
 #include <typeinfo>
 
 #define MESSAGE_CTOR(x, ...) x(__VA_ARGS__) : Message(typeid(x).hash_code())
@@ -34,6 +35,11 @@ public:
 		return m_hash == hash;
 	}
 
+	size_t GetHash(void) const
+	{
+		return m_hash;
+	}
+
 protected:
 	explicit Message(size_t hash)
 		: m_hash(hash)
@@ -0,0 +1,273 @@
+// Copyright (C) 2023  Mantas Naujokas
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "MessageJournal.h"
+#include <iterator>
+#include <stdio.h>
+#include <string.h>
+
+MessageJournal::MessageJournal(void)
+	: m_mode(Mode::None)
+	, m_frame(0U)
+	, m_frameRecords(0U)
+	, m_nextTypeID(0U)
+	, m_replayOffset(0U)
+{}
+
+MessageJournal::~MessageJournal(void)
+{
+	Stop();
+}
+
+bool MessageJournal::StartRecording(const std::string& path)
+{
+	Stop();
+
+	m_file.open(path, std::ios::binary | std::ios::trunc);
+	if (!m_file.is_open())
+	{
+		fprintf(stderr, "MessageJournal::%s: cannot open \"%s\" for writing\n", __func__, path.c_str());
+		return false;
+	}
+
+	std::vector<uint8_t> header;
+	BinaryWriter writer(header);
+	writer.Write(FILE_MAGIC);
+	writer.Write(FILE_VERSION);
+	m_file.write(reinterpret_cast<const char*>(header.data()), header.size());
+
+	for (std::pair<const size_t, JournalType>& it : m_types)
+	{
+		it.second.m_id = UINT16_MAX;
+	}
+	m_nextTypeID = 0U;
+	m_mode = Mode::Record;
+	return true;
+}
+
+bool MessageJournal::StartReplay(const std::string& path)
+{
+	Stop();
+
+	std::ifstream file(path, std::ios::binary);
+	if (!file.is_open())
+	{
+		fprintf(stderr, "MessageJournal::%s: cannot open \"%s\"\n", __func__, path.c_str());
+		return false;
+	}
+	m_replayData.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+	BinaryReader reader(m_replayData.data(), m_replayData.size());
+	uint32_t magic = 0U;
+	uint32_t version = 0U;
+	reader.Read(magic);
+	reader.Read(version);
+	if (!reader.IsValid() || magic != FILE_MAGIC || version != FILE_VERSION)
+	{
+		fprintf(stderr, "MessageJournal::%s: \"%s\" is not a version %u journal\n", __func__, path.c_str(), FILE_VERSION);
+		Reset();
+		return false;
+	}
+
+	m_replayOffset = reader.GetOffset();
+	m_mode = Mode::Replay;
+	return true;
+}
+
+void MessageJournal::Stop(void)
+{
+	if (m_mode == Mode::Record)
+	{
+		EndFrame();
+		m_file.close();
+	}
+	Reset();
+}
+
+bool MessageJournal::IsRecording(void) const
+{
+	return m_mode == Mode::Record;
+}
+
+bool MessageJournal::IsReplaying(void) const
+{
+	return m_mode == Mode::Replay;
+}
+
+bool MessageJournal::IsJournaled(size_t messageHash) const
+{
+	return m_types.find(messageHash) != m_types.end();
+}
+
+void MessageJournal::SendFrame(Messenger& messenger)
+{
+	if (m_mode != Mode::Replay)
+	{
+		return;
+	}
+
+	while (m_replayOffset < m_replayData.size())
+	{
+		BinaryReader reader(m_replayData.data() + m_replayOffset, m_replayData.size() - m_replayOffset);
+		uint8_t tag = 0U;
+		reader.Read(tag);
+		if (tag == TAG_TYPE)
+		{
+			ReadTypeBlock(reader);	// a bad block leaves reader invalid, replay stops below
+		}
+		else if (tag == TAG_FRAME)
+		{
+			uint64_t frame = 0U;
+			uint32_t count = 0U;
+			reader.Read(frame);
+			reader.Read(count);
+			if (reader.IsValid() && frame > m_frame)
+			{ // block belongs to a later frame
+				break;
+			}
+
+			for (uint32_t i = 0U; i < count && reader.IsValid(); ++i)
+			{
+				uint16_t id = 0U;
+				uint32_t size = 0U;
+				reader.Read(id);
+				reader.Read(size);
+				size_t recordOffset = m_replayOffset + reader.GetOffset();
+				if (!reader.IsValid() || !reader.Skip(size))
+				{
+					break;
+				}
+
+				std::map<uint16_t, const JournalType*>::const_iterator typeIter = m_replayTypes.find(id);
+				if (typeIter != m_replayTypes.end() && frame == m_frame)
+				{
+					BinaryReader messageReader(m_replayData.data() + recordOffset, size);
+					if (!typeIter->second->m_send(messageReader, messenger))
+					{
+						fprintf(stderr, "MessageJournal::%s: corrupted \"%s\" record on frame %llu\n", __func__,
+							typeIter->second->m_name.c_str(), static_cast<unsigned long long>(frame));
+					}
+				}
+			}
+		}
+		else
+		{
+			reader.Skip(m_replayData.size());	// marks reader invalid
+		}
+
+		if (!reader.IsValid())
+		{
+			fprintf(stderr, "MessageJournal::%s: journal is corrupted, replay stopped\n", __func__);
+			Reset();
+			return;
+		}
+		m_replayOffset += reader.GetOffset();
+	}
+}
+
+void MessageJournal::Record(const Message* message)
+{
+	if (m_mode != Mode::Record)
+	{
+		return;
+	}
+
+	std::map<size_t, JournalType>::iterator typeIter = m_types.find(message->GetHash());
+	if (typeIter == m_types.end())
+	{
+		return;
+	}
+
+	JournalType& type = typeIter->second;
+	if (type.m_id == UINT16_MAX)
+	{ // type block is written before the frame that first uses it
+		type.m_id = m_nextTypeID++;
+
+		std::vector<uint8_t> block;
+		BinaryWriter writer(block);
+		writer.Write(TAG_TYPE);
+		writer.Write(type.m_id);
+		writer.WriteString(type.m_name);
+		m_file.write(reinterpret_cast<const char*>(block.data()), block.size());
+	}
+
+	BinaryWriter writer(m_frameBuffer);
+	writer.Write(type.m_id);
+	size_t sizeOffset = writer.GetSize();
+	writer.Write(static_cast<uint32_t>(0U));
+	type.m_write(message, writer);
+
+	uint32_t size = static_cast<uint32_t>(writer.GetSize() - sizeOffset - sizeof(uint32_t));
+	memcpy(m_frameBuffer.data() + sizeOffset, &size, sizeof(size));
+	++m_frameRecords;
+}
+
+void MessageJournal::EndFrame(void)
+{
+	if (m_mode == Mode::Record && m_frameRecords > 0U)
+	{
+		std::vector<uint8_t> header;
+		BinaryWriter writer(header);
+		writer.Write(TAG_FRAME);
+		writer.Write(m_frame);
+		writer.Write(m_frameRecords);
+		m_file.write(reinterpret_cast<const char*>(header.data()), header.size());
+		m_file.write(reinterpret_cast<const char*>(m_frameBuffer.data()), m_frameBuffer.size());
+
+		m_frameBuffer.clear();
+		m_frameRecords = 0U;
+	}
+	else if (m_mode == Mode::Replay && m_replayOffset >= m_replayData.size())
+	{ // journal finished, live messages are used again
+		Reset();
+		return;
+	}
+	++m_frame;
+}
+
+void MessageJournal::Reset(void)
+{
+	m_mode = Mode::None;
+	m_frame = 0U;
+	m_frameBuffer.clear();
+	m_frameRecords = 0U;
+	m_replayData.clear();
+	m_replayOffset = 0U;
+	m_replayTypes.clear();
+}
+
+bool MessageJournal::ReadTypeBlock(BinaryReader& reader)
+{
+	uint16_t id = 0U;
+	std::string name;
+	reader.Read(id);
+	reader.ReadString(name);
+	if (!reader.IsValid())
+	{
+		return false;
+	}
+
+	for (const std::pair<const size_t, JournalType>& it : m_types)
+	{
+		if (it.second.m_name == name)
+		{
+			m_replayTypes[id] = &it.second;
+			return true;
+		}
+	}
+
+	fprintf(stderr, "MessageJournal::%s: message type \"%s\" is not registered, its records are skipped\n", __func__, name.c_str());
+	return true;
+}
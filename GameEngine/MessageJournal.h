@@ -0,0 +1,132 @@
+// Copyright (C) 2023  Mantas Naujokas
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef MESSAGEJOURNAL_H
+#define MESSAGEJOURNAL_H
+
+#include "BinaryStream.h"
+#include "Message.h"
+#include "Messenger.h"
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/* MessageJournal - records broadcast messages of registered types as Messenger dispatches them, frame by frame.
+A recorded journal replayed into another run sends the same messages on the same frames, live messages of
+journaled types are dropped while replaying. Journaled types implement:
+	void WriteBinary(BinaryWriter& writer) const;
+	static MessageType ReadBinary(BinaryReader& reader); */
+class MessageJournal
+{
+public:
+	MessageJournal(void);
+	~MessageJournal(void);
+
+	// RegisterType: name is stored in the journal and has to stay the same between recording and replay
+	template <typename MessageType>
+	void RegisterType(const std::string& name);
+
+	bool StartRecording(const std::string& path);
+	bool StartReplay(const std::string& path);
+	void Stop(void);	// flushes a recording
+
+	bool IsRecording(void) const;
+	bool IsReplaying(void) const;
+	bool IsJournaled(size_t messageHash) const;
+
+	/* Messenger hooks. SendFrame sends the journal's messages of the current frame, EndFrame writes recorded ones */
+	void SendFrame(Messenger& messenger);
+	void Record(const Message* message);
+	void EndFrame(void);
+
+	static constexpr uint32_t FILE_MAGIC = 0x4C4E4A4DU;	// "MJNL"
+	static constexpr uint32_t FILE_VERSION = 3U;	// increase when a journaled type's Write/ReadBinary layout changes
+
+private:
+	struct JournalType
+	{
+		std::string m_name;
+		uint16_t m_id = UINT16_MAX;	// assigned when first recorded
+		void (*m_write)(const Message* message, BinaryWriter& writer) = nullptr;
+		bool (*m_send)(BinaryReader& reader, Messenger& messenger) = nullptr;
+	};
+
+	template <typename MessageType>
+	static void WriteMessage(const Message* message, BinaryWriter& writer);
+	template <typename MessageType>
+	static bool ReplayMessage(BinaryReader& reader, Messenger& messenger);
+
+	void Reset(void);
+	bool ReadTypeBlock(BinaryReader& reader);
+
+private:
+	/* Journal blocks: TAG_TYPE u16 id, name; TAG_FRAME u64 frame, u32 count, count * (u16 id, u32 size, data) */
+	static constexpr uint8_t TAG_TYPE = 1U;
+	static constexpr uint8_t TAG_FRAME = 2U;
+
+	std::map<size_t, JournalType> m_types;	// by message type hash
+
+	enum class Mode
+	{
+		None,
+		Record,
+		Replay
+	};
+	std::atomic<Mode> m_mode;	// read by Messenger::Send on worker threads
+	uint64_t m_frame;	// Dispatch calls since recording or replay started
+
+	/* Recording */
+	std::ofstream m_file;
+	std::vector<uint8_t> m_frameBuffer;	// current frame's records
+	uint32_t m_frameRecords;
+	uint16_t m_nextTypeID;
+
+	/* Replay */
+	std::vector<uint8_t> m_replayData;
+	size_t m_replayOffset;	// start of the next unread block
+	std::map<uint16_t, const JournalType*> m_replayTypes;
+};
+
+template <typename MessageType>
+void MessageJournal::RegisterType(const std::string& name)
+{
+	JournalType& type = m_types[typeid(MessageType).hash_code()];
+	type.m_name = name;
+	type.m_write = &WriteMessage<MessageType>;
+	type.m_send = &ReplayMessage<MessageType>;
+}
+
+template <typename MessageType>
+void MessageJournal::WriteMessage(const Message* message, BinaryWriter& writer)
+{
+	static_cast<const MessageType*>(message)->WriteBinary(writer);
+}
+
+template <typename MessageType>
+bool MessageJournal::ReplayMessage(BinaryReader& reader, Messenger& messenger)
+{
+	MessageType message = MessageType::ReadBinary(reader);
+	if (!reader.IsValid())
+	{
+		return false;
+	}
+	messenger.Send(message);
+	return true;
+}
+
+#endif
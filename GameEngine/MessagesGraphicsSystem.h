@@ -17,10 +17,11 @@
 #define MESSAGESGRAPHICSSYSTEM_H
 
 #include "Message.h"
+#include "BinaryStream.h"
 #include <string>
 
-class GraphicsComponent;
 class Material;
+class Model;
 
 class WindowResizeMessage : public Message
 {
@@ -32,6 +33,21 @@ public:
 		, m_height(height)
 	{}
 
+	/* Journal serialization */
+	void WriteBinary(BinaryWriter& writer) const
+	{
+		writer.Write(m_width);
+		writer.Write(m_height);
+	}
+
+	static WindowResizeMessage ReadBinary(BinaryReader& reader)
+	{
+		WindowResizeMessage message;
+		reader.Read(message.m_width);
+		reader.Read(message.m_height);
+		return message;
+	}
+
 public:
 	uint32_t m_width;
 	uint32_t m_height;
@@ -42,14 +58,26 @@ class MaterialRequestMessage : public Message
 public:
 	MESSAGE_CTOR(MaterialRequestMessage,
 		const std::string& materialName,
-		GraphicsComponent& componentRef)
+		uint64_t replyAddress)
 		, m_materialName(materialName)
-		, m_componentRef(componentRef)
+		, m_replyAddress(replyAddress)
 	{}
 
 public:
 	std::string m_materialName;
-	GraphicsComponent& m_componentRef;
+	uint64_t m_replyAddress;	// requester's Messenger address, MaterialReadyMessage is sent there
+};
+
+class MaterialReadyMessage : public Message
+{
+public:
+	MESSAGE_CTOR(MaterialReadyMessage,
+		const Material* material = nullptr)
+		, m_material(material)
+	{}
+
+public:
+	const Material* m_material;	// GraphicsSystem's material, receivers make a copy. nullptr if it does not exist
 };
 
 class ModelRequestMessage : public Message
@@ -57,14 +85,26 @@ class ModelRequestMessage : public Message
 public:
 	MESSAGE_CTOR(ModelRequestMessage,
 		const std::string& modelName,
-		GraphicsComponent& componentRef)
+		uint64_t replyAddress)
 		, m_modelName(modelName)
-		, m_componentRef(componentRef)
+		, m_replyAddress(replyAddress)
 	{}
 
 public:
 	std::string m_modelName;
-	GraphicsComponent& m_componentRef;
+	uint64_t m_replyAddress;	// requester's Messenger address, ModelReadyMessage is sent there
+};
+
+class ModelReadyMessage : public Message
+{
+public:
+	MESSAGE_CTOR(ModelReadyMessage,
+		Model* model = nullptr)
+		, m_model(model)
+	{}
+
+public:
+	Model* m_model;	// nullptr if the model does not exist
 };
 
 class AssignTextureToMaterialMessage : public Message
@@ -15,28 +15,71 @@
 
 #include "MessagesInput.h"
 
+/* Key state checks combine the key's 64-bit words of both states and test the key's bit */
+static bool IsKeyBitSet(uint64_t word, unsigned char key)
+{
+	return ((word >> (key & 63U)) & 1U) != 0U;
+}
+
+/* Binary layout uses fixed width fields like InputRecorder snapshots, journals do not depend on struct padding or int size */
+static void WriteKeyStates(const KeyStates& keys, BinaryWriter& writer)
+{
+	for (uint64_t word : keys.m_words)
+	{
+		writer.Write(word);
+	}
+}
+
+static void ReadKeyStates(KeyStates& keys, BinaryReader& reader)
+{
+	for (uint64_t& word : keys.m_words)
+	{
+		reader.Read(word);
+	}
+}
+
+static void WriteMouseCoordinates(const MouseCoordinates& coordinates, BinaryWriter& writer)
+{
+	writer.Write(static_cast<int32_t>(coordinates.x));
+	writer.Write(static_cast<int32_t>(coordinates.y));
+}
+
+static void ReadMouseCoordinates(MouseCoordinates& coordinates, BinaryReader& reader)
+{
+	int32_t x = 0;
+	int32_t y = 0;
+	reader.Read(x);
+	reader.Read(y);
+	coordinates.x = x;
+	coordinates.y = y;
+}
+
 bool InputMessage::IsKeyTriggered(VIRTUAL_KEYS key) const
 {
 	unsigned char cKey = static_cast<unsigned char>(key);
-	return m_curKeyState[cKey] && !m_prevKeyState[cKey];	// states: current down, previous up
+	uint32_t word = cKey >> 6U;
+	return IsKeyBitSet(m_curKeyState.m_words[word] & ~m_prevKeyState.m_words[word], cKey);	// states: current down, previous up
 }
 
 bool InputMessage::IsKeyPressed(VIRTUAL_KEYS key) const
 {
 	unsigned char cKey = static_cast<unsigned char>(key);
-	return m_curKeyState[cKey] && m_prevKeyState[cKey];	// states: current down, previous down
+	uint32_t word = cKey >> 6U;
+	return IsKeyBitSet(m_curKeyState.m_words[word] & m_prevKeyState.m_words[word], cKey);	// states: current down, previous down
 }
 
 bool InputMessage::IsKeyReleased(VIRTUAL_KEYS key) const
 {
 	unsigned char cKey = static_cast<unsigned char>(key);
-	return !m_curKeyState[cKey] && m_prevKeyState[cKey];	// states: current up, previous down
+	uint32_t word = cKey >> 6U;
+	return IsKeyBitSet(~m_curKeyState.m_words[word] & m_prevKeyState.m_words[word], cKey);	// states: current up, previous down
 }
 
 bool InputMessage::IsKeyUp(VIRTUAL_KEYS key) const
 {
 	unsigned char cKey = static_cast<unsigned char>(key);
-	return !m_curKeyState[cKey] && !m_prevKeyState[cKey];	// states: current up, previous up
+	uint32_t word = cKey >> 6U;
+	return IsKeyBitSet(~(m_curKeyState.m_words[word] | m_prevKeyState.m_words[word]), cKey);	// states: current up, previous up
 }
 
 bool InputMessage::IsScroll(void) const
@@ -58,3 +101,27 @@ int InputMessage::GetScrollWheelDelta(void) const
 {
 	return m_deltaMouseWheel;
 }
+
+void InputMessage::WriteBinary(BinaryWriter& writer) const
+{
+	WriteKeyStates(m_curKeyState, writer);
+	WriteKeyStates(m_prevKeyState, writer);
+	WriteMouseCoordinates(m_curMouseCoordinates, writer);
+	WriteMouseCoordinates(m_prevMouseCoordinates, writer);
+	writer.Write(static_cast<int32_t>(m_deltaMouseWheel));
+}
+
+InputMessage InputMessage::ReadBinary(BinaryReader& reader)
+{
+	KeyStates curKeyState = {};
+	KeyStates prevKeyState = {};
+	MouseCoordinates curMouseCoordinates = {};
+	MouseCoordinates prevMouseCoordinates = {};
+	int32_t deltaMouseWheel = 0;
+	ReadKeyStates(curKeyState, reader);
+	ReadKeyStates(prevKeyState, reader);
+	ReadMouseCoordinates(curMouseCoordinates, reader);
+	ReadMouseCoordinates(prevMouseCoordinates, reader);
+	reader.Read(deltaMouseWheel);
+	return InputMessage(curKeyState, prevKeyState, curMouseCoordinates, prevMouseCoordinates, deltaMouseWheel);
+}
@@ -17,26 +17,24 @@
 #define MESSAGESINPUT_H
 
 #include "Message.h"
+#include "BinaryStream.h"
 #include "InputParameters.h"
 
 class InputMessage : public Message
 {
 public:
 	MESSAGE_CTOR(InputMessage,
-		const bool* curKeyState,
-		const bool* prevKeyState,
+		const KeyStates& curKeyState,
+		const KeyStates& prevKeyState,
 		const MouseCoordinates& curMouseCoordinates,
 		const MouseCoordinates& prevMouseCoordinates,
 		int deltaMouseWheel)
-		, m_curKeyState{}
-		, m_prevKeyState{}
+		, m_curKeyState(curKeyState)
+		, m_prevKeyState(prevKeyState)
 		, m_curMouseCoordinates(curMouseCoordinates)
 		, m_prevMouseCoordinates(prevMouseCoordinates)
 		, m_deltaMouseWheel(deltaMouseWheel)
-	{
-		memcpy(m_curKeyState, curKeyState, sizeof(m_curKeyState));
-		memcpy(m_prevKeyState, prevKeyState, sizeof(m_prevKeyState));
-	}
+	{}
 
 	/* Input state checkers: accept virtual key values defined in InputParameters.h */
 	bool IsKeyTriggered(VIRTUAL_KEYS key) const;
@@ -52,10 +50,14 @@ public:
 	MouseCoordinates GetMouseDeltas(void) const;
 	int GetScrollWheelDelta(void) const;
 
+	/* Journal serialization */
+	void WriteBinary(BinaryWriter& writer) const;
+	static InputMessage ReadBinary(BinaryReader& reader);
+
 private:
 	/* Key states - track current and previous key states */
-	bool m_curKeyState[kNumVirtualKeys];
-	bool m_prevKeyState[kNumVirtualKeys];
+	KeyStates m_curKeyState;
+	KeyStates m_prevKeyState;
 
 	/* Mouse positions - track current and previous positions */
 	MouseCoordinates m_curMouseCoordinates;
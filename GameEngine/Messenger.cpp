@@ -14,23 +14,70 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "Messenger.h"
+#include "JobSystem.h"
+#include "MessageJournal.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <imgui.h>
+
+static thread_local const Messenger* tProducerOwner = nullptr;
+static thread_local void* tProducer = nullptr;
+static thread_local bool tIsReplaying = false;	// set while the journal sends recorded messages
 
 Messenger::Messenger(void)
 {}
 
 Messenger::~Messenger(void)
-{}
+{
+	for (std::unique_ptr<Producer>& producer : m_producers)
+	{
+		if (producer == nullptr)
+		{
+			continue;
+		}
+
+		for (MessageQueue& queue : producer->m_queues)
+		{
+			for (QueuedMessage& queued : queue.m_messages)
+			{
+				queued.m_type->m_destroy(queued.m_message);
+			}
+		}
+	}
+}
 
 void Messenger::Unsubscribe(Subscriber* subscriber)
 {
 	if (subscriber != nullptr)
 	{
+		if (subscriber->m_address != UINT64_MAX)
+		{
+			m_mailboxes.erase(subscriber->m_address);
+			subscriber->m_address = UINT64_MAX;
+		}
+
 		size_t index = subscriber->m_bindingSlotIndex;
 		if (index != UINT64_MAX)
 		{
+			for (const Handler& binding : m_messageBindings[index].m_handlers)
+			{
+				if (binding.m_addressedOnly)
+				{
+					continue;
+				}
+
+				/* Erasing here would make tearing down N subscribers O(N^2), and lists may be iterated by Dispatch */
+				std::vector<Handler>& handlers = binding.m_invokeBatch != nullptr ? m_batchSubscribers[binding.m_messageHash] : m_subscribers[binding.m_messageHash];
+				handlers[binding.m_listIndex].m_subscriber = nullptr;
+				m_hasRemovedSubscribers = true;
+			}
+
 			m_messageBindings[index].m_subscriber = nullptr;
-			m_messageBindings[index].msgHashes.clear();
+			m_messageBindings[index].m_handlers.clear();
 			m_availableBindings.push_back(index);
+			subscriber->m_bindingSlotIndex = UINT64_MAX;
 		}
 	}
 	else
@@ -41,25 +88,519 @@ void Messenger::Unsubscribe(Subscriber* subscriber)
 
 void Messenger::Dispatch(void)
 {
-	std::vector<Message*>* sendfromQueue = m_activeQueue;
-	size_t newQueueIndex = (m_activeQueue - m_messages + 1U) % NUM_QUEUES;
-	m_activeQueue = &m_messages[newQueueIndex];
+	PROFILE_SCOPE("Messenger::Dispatch");
+	std::chrono::steady_clock::time_point dispatchStart = std::chrono::steady_clock::now();
+
+	if (m_journal != nullptr)
+	{ // kept apart, live messages sent earlier in the frame are already queued
+		Outbox* previousOutbox = BindOutbox(&m_replayOutbox);
+		tIsReplaying = true;
+		m_journal->SendFrame(*this);
+		tIsReplaying = false;
+		BindOutbox(previousOutbox);
+	}
+
+	GetProducers(m_dispatchProducers);
+	m_dispatchQueues.clear();
+	for (Producer* producer : m_dispatchProducers)
+	{
+		uint8_t sendfromQueue = producer->m_activeQueue.load();
+		producer->m_activeQueue.store(static_cast<uint8_t>((sendfromQueue + 1U) % NUM_QUEUES));
+		while (producer->m_isWriting.load())
+		{ // a Send that read the old index is still writing to it
+			std::this_thread::yield();
+		}
+		m_dispatchQueues.push_back(sendfromQueue);
+	}
+
+	/* Messages are destroyed after all queues are delivered: merged outbox messages live in other producers' storage.
+	Replayed messages go first, they were recorded in the order this frame's live messages had */
+	for (size_t i = 0U; i <= m_dispatchProducers.size(); ++i)
+	{
+		const std::vector<QueuedMessage>& messages = i == 0U ? m_replayOutbox.m_messages : m_dispatchProducers[i - 1U]->m_queues[m_dispatchQueues[i - 1U]].m_messages;
+		for (const QueuedMessage& queued : messages)
+		{
+			if (m_journal != nullptr && queued.m_address == BROADCAST_ADDRESS)
+			{
+				m_journal->Record(queued.m_message);
+			}
+
+			MessageStats& stats = m_stats[queued.m_message->GetHash()];
+			if (m_isTimingEnabled)
+			{
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				stats.m_handlerCalls += Deliver(queued);
+				std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+				stats.m_dispatchTime += elapsed.count();
+			}
+			else
+			{
+				stats.m_handlerCalls += Deliver(queued);
+			}
+
+			stats.m_name = queued.m_type->m_name;
+			++stats.m_sent;
+			stats.m_bytes += queued.m_type->m_size;
+		}
+	}
+	DeliverBatches();
+
+	if (m_journal != nullptr)
+	{
+		m_journal->EndFrame();
+	}
+
+	for (QueuedMessage& queued : m_replayOutbox.m_messages)
+	{
+		queued.m_type->m_destroy(queued.m_message);
+	}
+	m_replayOutbox.m_messages.clear();
+
+	for (size_t i = 0U; i < m_dispatchProducers.size(); ++i)
+	{
+		MessageQueue& sendfromQueue = m_dispatchProducers[i]->m_queues[m_dispatchQueues[i]];
+		for (QueuedMessage& queued : sendfromQueue.m_messages)
+		{
+			queued.m_type->m_destroy(queued.m_message);
+		}
+		sendfromQueue.m_messages.clear();
+		sendfromQueue.m_arena.Release();
+	}
+
+	std::chrono::duration<double, std::milli> dispatchTime = std::chrono::steady_clock::now() - dispatchStart;
+	m_lastDispatchTime = dispatchTime.count();
+	m_totalDispatchTime += m_lastDispatchTime;
+	++m_numDispatches;
+
+	if (m_hasRemovedSubscribers)
+	{
+		CompactSubscribers();
+	}
+}
+
+void Messenger::SetAddress(Subscriber* subscriber, uint64_t address)
+{
+	if (subscriber == nullptr || address == BROADCAST_ADDRESS)
+	{
+		fprintf(stderr, "Messenger::%s: invalid subscriber or address\n", __func__);
+		return;
+	}
+
+	std::pair<std::unordered_map<uint64_t, Subscriber*>::iterator, bool> inserted = m_mailboxes.emplace(address, subscriber);
+	if (!inserted.second && inserted.first->second != subscriber)
+	{
+		fprintf(stderr, "Messenger::%s: address %llu is already taken\n", __func__, static_cast<unsigned long long>(address));
+		return;
+	}
+
+	if (subscriber->m_address != UINT64_MAX && subscriber->m_address != address)
+	{
+		m_mailboxes.erase(subscriber->m_address);
+	}
+	subscriber->m_address = address;
+}
+
+uint64_t Messenger::GetAddress(Subscriber* subscriber)
+{
+	if (subscriber == nullptr)
+	{
+		fprintf(stderr, "Messenger::%s: subscriber was nullptr\n", __func__);
+		return BROADCAST_ADDRESS;
+	}
+
+	if (subscriber->m_address == UINT64_MAX)
+	{
+		SetAddress(subscriber, m_nextAutoAddress++);
+	}
+	return subscriber->m_address;
+}
+
+void Messenger::SetJournal(MessageJournal* journal)
+{
+	m_journal = journal;
+}
+
+Messenger::Outbox* Messenger::BindOutbox(Outbox* outbox)
+{
+	return static_cast<Outbox*>(JobSystem::SetJobLocal(JobSystem::JobLocal::Outbox, outbox));
+}
+
+void Messenger::MergeOutbox(Outbox& outbox)
+{
+	Outbox* boundOutbox = static_cast<Outbox*>(JobSystem::GetJobLocal(JobSystem::JobLocal::Outbox));
+	if (boundOutbox != nullptr && boundOutbox != &outbox)
+	{ // merged again by the outer outbox's owner
+		boundOutbox->m_messages.insert(boundOutbox->m_messages.end(), outbox.m_messages.begin(), outbox.m_messages.end());
+		outbox.m_messages.clear();
+		return;
+	}
+
+	Producer& producer = GetProducer();
+	producer.m_isWriting.store(true);
+	std::vector<QueuedMessage>& messages = producer.m_queues[producer.m_activeQueue.load()].m_messages;
+	messages.insert(messages.end(), outbox.m_messages.begin(), outbox.m_messages.end());
+	producer.m_isWriting.store(false);
+	outbox.m_messages.clear();
+}
+
+size_t Messenger::GetPeakQueueBytes(void) const
+{
+	size_t peak = 0U;
+	std::lock_guard<std::mutex> lock(m_producersMutex);
+	for (const std::unique_ptr<Producer>& producer : m_producers)
+	{
+		if (producer == nullptr)
+		{
+			continue;
+		}
+
+		for (const MessageQueue& queue : producer->m_queues)
+		{
+			peak = std::max(peak, queue.m_arena.GetPeakUsedBytes());
+		}
+	}
+	return peak;
+}
+
+size_t Messenger::GetQueueCapacity(void) const
+{
+	size_t capacity = 0U;
+	std::lock_guard<std::mutex> lock(m_producersMutex);
+	for (const std::unique_ptr<Producer>& producer : m_producers)
+	{
+		if (producer == nullptr)
+		{
+			continue;
+		}
+
+		for (const MessageQueue& queue : producer->m_queues)
+		{
+			capacity += queue.m_arena.GetCapacity();
+		}
+	}
+	return capacity;
+}
+
+void Messenger::SetTimingEnabled(bool enabled)
+{
+	m_isTimingEnabled = enabled;
+}
+
+void Messenger::ShowStatistics(void) const
+{
+	ImGui::Begin("Messenger");
+	ImGui::Text("Dispatch: %.3f ms (avg %.3f ms)", m_lastDispatchTime, m_numDispatches > 0U ? m_totalDispatchTime / m_numDispatches : 0.0);
+	ImGui::Text("Queue storage: %zu / %zu KB", GetPeakQueueBytes() / 1024U, GetQueueCapacity() / 1024U);
+
+	if (ImGui::BeginTable("Messages", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+	{
+		ImGui::TableSetupColumn("Type");
+		ImGui::TableSetupColumn("Sent");
+		ImGui::TableSetupColumn("KB");
+		ImGui::TableSetupColumn("Handler calls");
+		ImGui::TableSetupColumn("Time (ms)");
+		ImGui::TableHeadersRow();
+
+		for (const std::pair<const size_t, MessageStats>& it : m_stats)
+		{
+			const MessageStats& stats = it.second;
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(stats.m_name);
+			ImGui::TableNextColumn();
+			ImGui::Text("%llu", static_cast<unsigned long long>(stats.m_sent));
+			ImGui::TableNextColumn();
+			ImGui::Text("%llu", static_cast<unsigned long long>(stats.m_bytes / 1024U));
+			ImGui::TableNextColumn();
+			ImGui::Text("%llu", static_cast<unsigned long long>(stats.m_handlerCalls));
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", stats.m_dispatchTime);
+		}
+
+		ImGui::EndTable();
+	}
+
+	ImGui::End();
+}
+
+bool Messenger::WriteStatisticsCSV(const std::string& path) const
+{
+	FILE* fp = fopen(path.c_str(), "w");
+	if (fp == nullptr)
+	{
+		fprintf(stderr, "Messenger::%s: failed to open \"%s\"\n", __func__, path.c_str());
+		return false;
+	}
+
+	fprintf(fp, "Type,Sent,Bytes,HandlerCalls,DispatchTimeMs\n");
+	for (const std::pair<const size_t, MessageStats>& it : m_stats)
+	{
+		const MessageStats& stats = it.second;
+		fprintf(fp, "\"%s\",%llu,%llu,%llu,%.3f\n", stats.m_name, static_cast<unsigned long long>(stats.m_sent),
+			static_cast<unsigned long long>(stats.m_bytes), static_cast<unsigned long long>(stats.m_handlerCalls), stats.m_dispatchTime);
+	}
+	fprintf(fp, "\"Dispatch total\",%llu,,,%.3f\n", static_cast<unsigned long long>(m_numDispatches), m_totalDispatchTime);
+
+	fclose(fp);
+	return true;
+}
+
+void Messenger::Enqueue(const MessageTypeInfo* type, const void* source, uint64_t address)
+{
+	if (m_journal != nullptr && !tIsReplaying && m_journal->IsReplaying() && m_journal->IsJournaled(type->m_hash))
+	{ // replayed from the journal instead
+		std::lock_guard<std::mutex> lock(m_droppedLiveTypesMutex);
+		if (m_droppedLiveTypes.insert(type->m_hash).second)
+		{
+			fprintf(stderr, "Messenger::%s: journal is replaying, live \"%s\" messages are dropped\n", __func__, type->m_name);
+		}
+		return;
+	}
 
-	for (Message* message : *sendfromQueue)
+	/* Outbox messages are stored in the sending thread's queue too, they are merged before the queue is dispatched */
+	Producer& producer = GetProducer();
+	producer.m_isWriting.store(true);
+	MessageQueue& queue = producer.m_queues[producer.m_activeQueue.load()];
+	void* storage = queue.m_arena.Allocate(type->m_size);
+	QueuedMessage queued = { type->m_construct(storage, source), type, address };
+	Outbox* boundOutbox = static_cast<Outbox*>(JobSystem::GetJobLocal(JobSystem::JobLocal::Outbox));
+	if (boundOutbox != nullptr)
 	{
-		for (MessageBindings& messageBinding : m_messageBindings)
+		boundOutbox->m_messages.push_back(queued);
+	}
+	else
+	{
+		queue.m_messages.push_back(queued);
+	}
+	producer.m_isWriting.store(false);
+}
+
+Messenger::Producer& Messenger::GetProducer(void)
+{
+	if (tProducerOwner != this)
+	{ // slot is the thread's fixed job system index, not the order threads happen to send first in
+		std::lock_guard<std::mutex> lock(m_producersMutex);
+		size_t slot = 0U;
+		if (JobSystem::IsJobThread())
 		{
-			for (size_t subscribedHash : messageBinding.msgHashes)
+			slot = JobSystem::GetThreadIndex();
+			if (slot >= m_numJobSlots)
+			{ // job thread slots stay in front of the other threads' ones
+				for (; m_numJobSlots <= slot; ++m_numJobSlots)
+				{
+					m_producers.insert(m_producers.begin() + m_numJobSlots, nullptr);
+				}
+				for (size_t i = m_numJobSlots; i < m_producers.size(); ++i)
+				{
+					m_producers[i]->m_id = i;
+				}
+			}
+		}
+		else
+		{ // threads the job system did not start would share index 0 with the main thread, they get their own slots after it
+			slot = m_producers.size();
+			m_producers.push_back(nullptr);
+		}
+		if (m_producers[slot] == nullptr)
+		{
+			m_producers[slot] = std::make_unique<Producer>();
+			m_producers[slot]->m_id = slot;
+		}
+		tProducer = m_producers[slot].get();
+		tProducerOwner = this;
+	}
+	return *static_cast<Producer*>(tProducer);
+}
+
+void Messenger::GetProducers(std::vector<Producer*>& producers)
+{
+	producers.clear();
+	std::lock_guard<std::mutex> lock(m_producersMutex);
+	for (std::unique_ptr<Producer>& producer : m_producers)
+	{
+		if (producer != nullptr)
+		{
+			producers.push_back(producer.get());
+		}
+	}
+}
+
+uint32_t Messenger::Deliver(const QueuedMessage& queued)
+{
+	const Message* message = queued.m_message;
+	uint32_t handlerCalls = 0U;
+	if (queued.m_address != BROADCAST_ADDRESS)
+	{
+		std::unordered_map<uint64_t, Subscriber*>::const_iterator mailbox = m_mailboxes.find(queued.m_address);
+		if (mailbox != m_mailboxes.end())
+		{
+			/* Subscriber's own binding for the type if it has one, ProcessMessage otherwise */
+			Subscriber* subscriber = mailbox->second;
+			if (subscriber->m_bindingSlotIndex != UINT64_MAX)
 			{
-				if (message->IsType(subscribedHash))
+				for (const Handler& handler : m_messageBindings[subscriber->m_bindingSlotIndex].m_handlers)
 				{
-					messageBinding.m_subscriber->ProcessMessage(message);
+					if (handler.m_messageHash == message->GetHash() && handler.m_invoke != nullptr)
+					{
+						handler.m_invoke(subscriber, handler.m_method, message);
+						return 1U;
+					}
 				}
 			}
+			subscriber->ProcessMessage(message);
+			return 1U;
 		}
+		return 0U;
+	}
+
+	std::unordered_map<size_t, std::vector<Handler>>::iterator handlersIter = m_subscribers.find(message->GetHash());
+	if (handlersIter != m_subscribers.end())
+	{
+		/* Indexed loop: handlers registered while dispatching are appended to the list */
+		std::vector<Handler>& handlers = handlersIter->second;
+		for (size_t i = 0U; i < handlers.size(); ++i)
+		{
+			const Handler& handler = handlers[i];
+			if (handler.m_subscriber == nullptr)
+			{
+				continue;
+			}
 
-		delete message;
+			if (handler.m_invoke != nullptr)
+			{
+				handler.m_invoke(handler.m_subscriber, handler.m_method, message);
+			}
+			else
+			{
+				handler.m_subscriber->ProcessMessage(message);
+			}
+			++handlerCalls;
+		}
 	}
 
-	sendfromQueue->clear();
+	if (m_batchSubscribers.find(message->GetHash()) != m_batchSubscribers.end())
+	{
+		std::vector<const Message*>& batch = m_batchedMessages[message->GetHash()];
+		if (batch.empty())
+		{
+			m_batchOrder.push_back(message->GetHash());
+		}
+		batch.push_back(message);
+	}
+	return handlerCalls;
+}
+
+void Messenger::DeliverBatches(void)
+{
+	/* Indexed loops: batch handlers may subscribe, and messages they send go to the next frame's queues */
+	for (size_t i = 0U; i < m_batchOrder.size(); ++i)
+	{
+		std::chrono::steady_clock::time_point start;
+		if (m_isTimingEnabled)
+		{
+			start = std::chrono::steady_clock::now();
+		}
+		MessageStats& stats = m_stats[m_batchOrder[i]];
+		std::vector<const Message*>& batch = m_batchedMessages[m_batchOrder[i]];
+		std::vector<Handler>& handlers = m_batchSubscribers[m_batchOrder[i]];
+		for (size_t j = 0U; j < handlers.size(); ++j)
+		{
+			const Handler& handler = handlers[j];
+			if (handler.m_subscriber != nullptr)
+			{
+				handler.m_invokeBatch(handler.m_subscriber, handler.m_method, batch.data(), batch.size());
+				++stats.m_handlerCalls;
+			}
+		}
+		batch.clear();
+
+		if (m_isTimingEnabled)
+		{
+			std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+			stats.m_dispatchTime += elapsed.count();
+		}
+	}
+	m_batchOrder.clear();
+}
+
+void Messenger::AddHandler(const Handler& handler)
+{
+	Subscriber* subscriber = handler.m_subscriber;
+	if (subscriber == nullptr)
+	{
+		fprintf(stderr, "Messenger::%s: subscriber was nullptr\n", __func__);
+		return;
+	}
+
+	std::vector<Handler>* handlers = nullptr;
+	if (!handler.m_addressedOnly)
+	{
+		handlers = handler.m_invokeBatch != nullptr ? &m_batchSubscribers[handler.m_messageHash] : &m_subscribers[handler.m_messageHash];
+	}
+
+	size_t useBindingIndex = subscriber->m_bindingSlotIndex;
+	if (useBindingIndex == UINT64_MAX)	// no binding for this subscriber
+	{
+		MessageBindings newBinding;
+		newBinding.m_subscriber = subscriber;
+		newBinding.m_handlers.push_back(handler);
+		newBinding.m_handlers.back().m_listIndex = handlers != nullptr ? handlers->size() : 0U;
+
+		if (!m_availableBindings.empty())
+		{
+			subscriber->m_bindingSlotIndex = useBindingIndex = m_availableBindings.back();
+			m_availableBindings.pop_back();
+
+			m_messageBindings[useBindingIndex] = newBinding;
+		}
+		else
+		{
+			subscriber->m_bindingSlotIndex = m_messageBindings.size();
+			m_messageBindings.push_back(newBinding);
+		}
+	}
+	else
+	{
+		std::vector<Handler>& existingHandlers = m_messageBindings[useBindingIndex].m_handlers;
+		for (const Handler& existing : existingHandlers)
+		{
+			if (existing.m_messageHash == handler.m_messageHash && (existing.m_invokeBatch == nullptr) == (handler.m_invokeBatch == nullptr)) // already registered
+			{
+				return;
+			}
+		}
+		existingHandlers.push_back(handler);
+		existingHandlers.back().m_listIndex = handlers != nullptr ? handlers->size() : 0U;
+	}
+
+	if (handlers != nullptr)
+	{
+		handlers->push_back(handler);
+	}
+}
+
+void Messenger::CompactSubscribers(void)
+{
+	for (std::unordered_map<size_t, std::vector<Handler>>* handlerLists : { &m_subscribers, &m_batchSubscribers })
+	{
+		for (std::pair<const size_t, std::vector<Handler>>& it : *handlerLists)
+		{
+			std::vector<Handler>& handlers = it.second;
+			handlers.erase(std::remove_if(handlers.begin(), handlers.end(),
+				[](const Handler& handler) { return handler.m_subscriber == nullptr; }), handlers.end());
+
+			for (size_t i = 0U; i < handlers.size(); ++i)
+			{
+				for (Handler& binding : m_messageBindings[handlers[i].m_subscriber->m_bindingSlotIndex].m_handlers)
+				{
+					if (binding.m_messageHash == handlers[i].m_messageHash && (binding.m_invokeBatch == nullptr) == (handlers[i].m_invokeBatch == nullptr))
+					{
+						binding.m_listIndex = i;
+						break;
+					}
+				}
+			}
+		}
+	}
+	m_hasRemovedSubscribers = false;
 }
@@ -17,92 +17,342 @@
 #define MESSENGER_H
 
 #include "Message.h"
+#include "MemoryArena.h"
 #include "Subscriber.h"
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+class MessageJournal;
+
+/* MessageSpan - all broadcast messages of one type dispatched in a frame, in send order */
+template <typename MessageType>
+class MessageSpan
+{
+public:
+	MessageSpan(const Message* const* messages, size_t count)
+		: m_messages(messages)
+		, m_count(count)
+	{}
+
+	size_t GetSize(void) const
+	{
+		return m_count;
+	}
+
+	const MessageType& operator[](size_t index) const
+	{
+		return *static_cast<const MessageType*>(m_messages[index]);
+	}
+
+private:
+	const Message* const* m_messages;
+	size_t m_count;
+};
+
 class Messenger
 {
 public:
 	Messenger();
 	~Messenger();
 
+	// RegisterMessage: legacy binding, messages of the type are passed to subscriber's ProcessMessage
 	template <typename MessageType>
 	void RegisterMessage(Subscriber* subscriber);
+	/* Subscribe: messages of the type are passed straight to handler, e.g. Subscribe<WindowResizeMessage>(this, &GraphicsSystem::OnWindowResize).
+	One binding per subscriber and message type, later calls for the same type are ignored */
+	template <typename MessageType, typename SubscriberType>
+	void Subscribe(SubscriberType* subscriber, void (SubscriberType::*handler)(const MessageType&));
+	// SubscribeAddressed: like Subscribe, but handler only gets messages sent to subscriber's address with SendTo
+	template <typename MessageType, typename SubscriberType>
+	void SubscribeAddressed(SubscriberType* subscriber, void (SubscriberType::*handler)(const MessageType&));
+	/* SubscribeBatch: handler is called once per Dispatch with every broadcast message of the type, after per-message handlers.
+	For subscribers that aggregate, e.g. counting hits, instead of a call per message */
+	template <typename MessageType, typename SubscriberType>
+	void SubscribeBatch(SubscriberType* subscriber, void (SubscriberType::*handler)(const MessageSpan<MessageType>&));
 	template <typename MessageType>
 	void Send(const MessageType& message);
+	// SendTo: delivers message only to the subscriber at address, subscriber does not need to register the type
+	template <typename MessageType>
+	void SendTo(uint64_t address, const MessageType& message);
+
+	/* Addresses: SetAddress binds an entity ID, GetAddress assigns one from AUTO_ADDRESS_BASE if subscriber has none.
+	Messages to addresses that are gone at dispatch are dropped. Main thread only, like RegisterMessage */
+	static const uint64_t AUTO_ADDRESS_BASE = 1ULL << 63U;
+	void SetAddress(Subscriber* subscriber, uint64_t address);
+	uint64_t GetAddress(Subscriber* subscriber);
 
 	// Remove subscriber from messenger bindings
 	void Unsubscribe(Subscriber* subscriber);
 
 	void Dispatch(void);
 
+	// SetJournal: journal records dispatched messages or replaces live ones while replaying, nullptr detaches
+	void SetJournal(MessageJournal* journal);
+
+	// Largest number of bytes messages of one frame took, for tuning QUEUE_CHUNK_SIZE
+	size_t GetPeakQueueBytes(void) const;
+	size_t GetQueueCapacity(void) const;
+
+	/* MessageTypeInfo - one per message type, queued messages are constructed and destroyed through it */
+	struct MessageTypeInfo
+	{
+		size_t m_hash;
+		const char* m_name;
+		size_t m_size;
+		Message* (*m_construct)(void* storage, const void* source);
+		void (*m_destroy)(Message* message);
+	};
+
+	/* QueuedMessage - message constructed in queue storage */
+	struct QueuedMessage
+	{
+		Message* m_message;
+		const MessageTypeInfo* m_type;
+		uint64_t m_address;	// BROADCAST_ADDRESS or the receiving subscriber's address
+	};
+
+	/* MessageStats - traffic of one message type since startup */
+	struct MessageStats
+	{
+		const char* m_name = "";
+		uint64_t m_sent = 0U;
+		uint64_t m_bytes = 0U;	// bytes copied into queues
+		uint64_t m_handlerCalls = 0U;	// handlers, batch handlers and mailbox deliveries invoked
+		double m_dispatchTime = 0.0;	// ms spent delivering, only measured while timing is enabled
+	};
+
+	/* SetTimingEnabled: measure dispatch time per message type, costs two clock reads per delivered message.
+	Off by default, counts and the total Dispatch time are always kept */
+	void SetTimingEnabled(bool enabled);
+	// Draws per-type message traffic in an ImGui window
+	void ShowStatistics(void) const;
+	// WriteStatisticsCSV: one row per message type, false if file could not be written
+	bool WriteStatisticsCSV(const std::string& path) const;
+
+	/* Outbox - while an outbox is bound to a thread, messages sent from it are kept there. Bindings are job locals,
+	jobs the thread runs while waiting send past them. MergeOutbox queues the messages, or moves them to the outbox
+	bound to the calling thread if there is one.
+	Merging outboxes in a fixed order keeps message order deterministic */
+	class Outbox
+	{
+	public:
+		friend class Messenger;
+
+	private:
+		std::vector<QueuedMessage> m_messages;
+	};
+
+	static Outbox* BindOutbox(Outbox* outbox);	// nullptr unbinds, returns the previous binding to restore
+	void MergeOutbox(Outbox& outbox);
+
+private:
+	static const uint8_t NUM_QUEUES = 2U;
+	static const size_t QUEUE_CHUNK_SIZE = 16U * 1024U;
+	static const uint64_t BROADCAST_ADDRESS = UINT64_MAX;
+
+	/* MessageQueue - messages of one frame. Storage is bump allocated and released in bulk after dispatch */
+	struct MessageQueue
+	{
+		MessageQueue(void) : m_arena(QUEUE_CHUNK_SIZE) {}
+
+		MemoryArena m_arena;
+		std::vector<QueuedMessage> m_messages;
+	};
+
+	/* Producer - queues of one sending thread, only that thread writes to them.
+	Dispatch flips m_activeQueue and waits while m_isWriting is set, so Send never takes a lock */
+	struct Producer
+	{
+		size_t m_id = 0U;
+		MessageQueue m_queues[NUM_QUEUES];
+		std::atomic<uint8_t> m_activeQueue{ 0U };
+		std::atomic<bool> m_isWriting{ false };
+	};
+
+	Producer& GetProducer(void);	// creates the calling thread's producer on first use
+	void GetProducers(std::vector<Producer*>& producers);
+
+	/* Handler - type erased binding. m_invoke casts the message and calls the member function stored in m_method,
+	legacy bindings leave both invoke functions nullptr and get ProcessMessage */
+	static const size_t MAX_METHOD_SIZE = 4U * sizeof(void*);	// member function pointers are up to 3 pointers on MSVC
+	struct Handler
+	{
+		size_t m_messageHash = 0U;
+		Subscriber* m_subscriber = nullptr;	// nullptr when unsubscribed during Dispatch
+		void (*m_invoke)(Subscriber* subscriber, const unsigned char* method, const Message* message) = nullptr;
+		// set instead of m_invoke for batch handlers
+		void (*m_invokeBatch)(Subscriber* subscriber, const unsigned char* method, const Message* const* messages, size_t count) = nullptr;
+		alignas(void*) unsigned char m_method[MAX_METHOD_SIZE] = {};
+		bool m_addressedOnly = false;	// kept in the subscriber's bindings only, not in the broadcast lists
+		size_t m_listIndex = 0U;	// position in the type's handler list, kept up to date in the subscriber's bindings
+	};
+
+	template <typename MessageType, typename SubscriberType>
+	static void InvokeMethod(Subscriber* subscriber, const unsigned char* method, const Message* message);
+	template <typename MessageType, typename SubscriberType>
+	static void InvokeBatchMethod(Subscriber* subscriber, const unsigned char* method, const Message* const* messages, size_t count);
+	void AddHandler(const Handler& handler);
+
+	template <typename MessageType>
+	static const MessageTypeInfo* GetTypeInfo(void);
+	template <typename MessageType>
+	static Message* ConstructMessage(void* storage, const void* source);
+	template <typename MessageType>
+	static void DestroyMessage(Message* message);
+
+	// Enqueue: constructs message in the active queue's storage
+	void Enqueue(const MessageTypeInfo* type, const void* source, uint64_t address);
+	uint32_t Deliver(const QueuedMessage& queued);	// returns the number of handlers invoked
+	void DeliverBatches(void);
+	void CompactSubscribers(void);	// drops unsubscribed entries and updates the bindings' list indices
+
 private:
 	struct MessageBindings
 	{
 		Subscriber* m_subscriber = nullptr;
-		std::vector<size_t> msgHashes;
+		std::vector<Handler> m_handlers;
 	};
 
 	std::vector<MessageBindings> m_messageBindings;
 	std::vector<size_t> m_availableBindings;
 
-	static const uint8_t NUM_QUEUES = 2U;
-	std::vector<Message*> m_messages[NUM_QUEUES];
-	std::vector<Message*>* m_activeQueue = m_messages;
+	// Handlers of each message type in registration order, Dispatch only visits these
+	std::unordered_map<size_t, std::vector<Handler>> m_subscribers;
+	std::unordered_map<size_t, std::vector<Handler>> m_batchSubscribers;
+	// Messages of batched types collected while delivering, types in order of their first message
+	std::unordered_map<size_t, std::vector<const Message*>> m_batchedMessages;
+	std::vector<size_t> m_batchOrder;
+	// Mailboxes: addressed messages go straight to the subscriber
+	std::unordered_map<uint64_t, Subscriber*> m_mailboxes;
+	uint64_t m_nextAutoAddress = AUTO_ADDRESS_BASE;
+	bool m_hasRemovedSubscribers = false;	// Unsubscribe leaves nullptr entries, Dispatch compacts the lists once
+
+	/* Producers by job system thread index, nullptr for threads that have not sent yet, then the producers
+	of other threads in the order they first sent. Dispatch delivers their messages in slot then send order */
+	std::vector<std::unique_ptr<Producer>> m_producers;
+	size_t m_numJobSlots = 0U;	// m_producers entries that belong to job system threads
+	mutable std::mutex m_producersMutex;	// only taken when a thread sends for the first time and by Dispatch
+	std::vector<Producer*> m_dispatchProducers;
+	std::vector<uint8_t> m_dispatchQueues;
+
+	MessageJournal* m_journal = nullptr;
+	Outbox m_replayOutbox;	// journal's messages of the frame, delivered before live ones in recorded order
+	std::unordered_set<size_t> m_droppedLiveTypes;	// journaled types whose live sends were dropped and logged
+	std::mutex m_droppedLiveTypesMutex;
+
+	std::unordered_map<size_t, MessageStats> m_stats;
+	bool m_isTimingEnabled = false;
+	uint64_t m_numDispatches = 0U;
+	double m_lastDispatchTime = 0.0;	// ms
+	double m_totalDispatchTime = 0.0;	// ms
 };
 
 template <typename MessageType>
 void Messenger::RegisterMessage(Subscriber* subscriber)
 {
-	if (subscriber != nullptr)
-	{
-		size_t messageHash = typeid(MessageType).hash_code();
-
-		size_t useBindingIndex = subscriber->m_bindingSlotIndex;
-		if (useBindingIndex == UINT64_MAX)	// no binding for this subscriber
-		{
-			MessageBindings newBinding;
-			newBinding.m_subscriber = subscriber;
-			newBinding.msgHashes.push_back(messageHash);
-
-			if (!m_availableBindings.empty())
-			{
-				subscriber->m_bindingSlotIndex = useBindingIndex = m_availableBindings.back();
-				m_availableBindings.pop_back();
-
-				m_messageBindings[useBindingIndex] = newBinding;
-			}
-			else
-			{
-				subscriber->m_bindingSlotIndex = m_messageBindings.size();
-				m_messageBindings.push_back(newBinding);
-			}
-		}
-		else
-		{
-			std::vector<size_t>& existingHashes = m_messageBindings[useBindingIndex].msgHashes;
-			for (size_t hash : existingHashes)
-			{
-				if (hash == messageHash) // already registered
-				{
-					return;
-				}
-			}
-			existingHashes.push_back(messageHash);
-		}
-	}
-	else
-	{
-		fprintf(stderr, "Messenger::%s: subscriber was nullptr\n", __func__);
-	}
+	Handler handler;
+	handler.m_messageHash = typeid(MessageType).hash_code();
+	handler.m_subscriber = subscriber;
+	AddHandler(handler);
+}
+
+template <typename MessageType, typename SubscriberType>
+void Messenger::Subscribe(SubscriberType* subscriber, void (SubscriberType::*handler)(const MessageType&))
+{
+	typedef void (SubscriberType::*Method)(const MessageType&);
+	static_assert(sizeof(Method) <= MAX_METHOD_SIZE, "Messenger::Subscribe: member function pointer does not fit Handler");
+
+	Handler binding;
+	binding.m_messageHash = typeid(MessageType).hash_code();
+	binding.m_subscriber = subscriber;
+	binding.m_invoke = &InvokeMethod<MessageType, SubscriberType>;
+	memcpy(binding.m_method, &handler, sizeof(Method));
+	AddHandler(binding);
+}
+
+template <typename MessageType, typename SubscriberType>
+void Messenger::SubscribeAddressed(SubscriberType* subscriber, void (SubscriberType::*handler)(const MessageType&))
+{
+	typedef void (SubscriberType::*Method)(const MessageType&);
+	static_assert(sizeof(Method) <= MAX_METHOD_SIZE, "Messenger::SubscribeAddressed: member function pointer does not fit Handler");
+
+	Handler binding;
+	binding.m_messageHash = typeid(MessageType).hash_code();
+	binding.m_subscriber = subscriber;
+	binding.m_invoke = &InvokeMethod<MessageType, SubscriberType>;
+	binding.m_addressedOnly = true;
+	memcpy(binding.m_method, &handler, sizeof(Method));
+	AddHandler(binding);
+}
+
+template <typename MessageType, typename SubscriberType>
+void Messenger::SubscribeBatch(SubscriberType* subscriber, void (SubscriberType::*handler)(const MessageSpan<MessageType>&))
+{
+	typedef void (SubscriberType::*Method)(const MessageSpan<MessageType>&);
+	static_assert(sizeof(Method) <= MAX_METHOD_SIZE, "Messenger::SubscribeBatch: member function pointer does not fit Handler");
+
+	Handler binding;
+	binding.m_messageHash = typeid(MessageType).hash_code();
+	binding.m_subscriber = subscriber;
+	binding.m_invokeBatch = &InvokeBatchMethod<MessageType, SubscriberType>;
+	memcpy(binding.m_method, &handler, sizeof(Method));
+	AddHandler(binding);
+}
+
+template <typename MessageType, typename SubscriberType>
+void Messenger::InvokeBatchMethod(Subscriber* subscriber, const unsigned char* method, const Message* const* messages, size_t count)
+{
+	typedef void (SubscriberType::*Method)(const MessageSpan<MessageType>&);
+	Method handler;
+	memcpy(&handler, method, sizeof(Method));
+	(static_cast<SubscriberType*>(subscriber)->*handler)(MessageSpan<MessageType>(messages, count));
+}
+
+template <typename MessageType, typename SubscriberType>
+void Messenger::InvokeMethod(Subscriber* subscriber, const unsigned char* method, const Message* message)
+{
+	typedef void (SubscriberType::*Method)(const MessageType&);
+	Method handler;
+	memcpy(&handler, method, sizeof(Method));	// copied first, handler may subscribe and move the handler lists
+	(static_cast<SubscriberType*>(subscriber)->*handler)(*static_cast<const MessageType*>(message));
 }
 
 template <typename MessageType>
 void Messenger::Send(const MessageType& message)
 {
-	Message* messagePtr = new MessageType(message);
-	
-	m_activeQueue->push_back(messagePtr);
+	Enqueue(GetTypeInfo<MessageType>(), &message, BROADCAST_ADDRESS);
+}
+
+template <typename MessageType>
+void Messenger::SendTo(uint64_t address, const MessageType& message)
+{
+	Enqueue(GetTypeInfo<MessageType>(), &message, address);
+}
+
+template <typename MessageType>
+const Messenger::MessageTypeInfo* Messenger::GetTypeInfo(void)
+{
+	static const MessageTypeInfo info = { typeid(MessageType).hash_code(), typeid(MessageType).name(), sizeof(MessageType), &ConstructMessage<MessageType>, &DestroyMessage<MessageType> };
+	return &info;
+}
+
+template <typename MessageType>
+Message* Messenger::ConstructMessage(void* storage, const void* source)
+{
+	return new (storage) MessageType(*static_cast<const MessageType*>(source));
+}
+
+template <typename MessageType>
+void Messenger::DestroyMessage(Message* message)
+{
+	static_cast<MessageType*>(message)->~MessageType();
 }
 
 #endif
@@ -15,6 +15,11 @@
 
 #include "Model.h"
 #include "JSONData.h"
+#include "Platform.h"
+
+#if PLATFORM_WIN32
+#include "DirectXUtil.h"
+#endif
 
 Model::Model(void)
 	: m_cullMode(CullMode::None)
@@ -23,7 +28,9 @@ Model::Model(void)
 
 Model::~Model(void)
 {
+#if PLATFORM_WIN32
 	SAFE_RELEASE(m_vertexBuffer);
+#endif
 }
 
 void Model::Deserialize(const JSONData& source)
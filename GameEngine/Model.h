@@ -18,7 +18,6 @@
 
 #include <string>
 #include "GraphicsDefines.h"
-#include "DirectXUtil.h"
 
 struct ID3D11Buffer;
 class JSONData;
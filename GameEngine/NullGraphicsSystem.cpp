@@ -0,0 +1,233 @@
+// Copyright (C) 2023  Mantas Naujokas
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "NullGraphicsSystem.h"
+#include "App.h"
+#include "GameObjectFactory.h"
+#include "WorldManager.h"
+#include "Camera.h"
+#include "GraphicsComponent.h"
+#include "SceneComponent.h"
+#include "MessageFileRequest.h"
+#include "MessagesGraphicsSystem.h"
+#include "Material.h"
+#include "Model.h"
+#include "JSONUtility.h"
+#include "JSONData.h"
+#include "StringUtility.h"
+#include <imgui.h>
+
+NullGraphicsSystem::NullGraphicsSystem(App* app, GameObjectFactory* GOF)
+	: ISystem(app, GOF)
+	, m_cameraData{}
+	, m_worldManager(nullptr)
+{}
+
+NullGraphicsSystem::~NullGraphicsSystem(void)
+{}
+
+bool NullGraphicsSystem::Initialize(INIReader* ini)
+{
+	FileRequestMessage frm;
+	frm.m_FileLoader = std::bind(&NullGraphicsSystem::ReadMaterialData, this, std::placeholders::_1);
+	frm.m_extension = ".mtrl";
+	m_messenger.Send(frm);
+
+	frm.m_FileLoader = std::bind(&NullGraphicsSystem::ReadModelData, this, std::placeholders::_1);
+	frm.m_extension = ".mdl";
+	m_messenger.Send(frm);
+
+	m_worldManager = WorldManager::Get();
+
+	return true;
+}
+
+const char* NullGraphicsSystem::GetName(void) const
+{
+	return "NullGraphicsSystem";
+}
+
+void NullGraphicsSystem::Update(float deltaTime)
+{
+	m_renderList.Clear();
+	m_meshData.clear();
+
+	Camera* camera = m_worldManager->GetActiveWorld()->GetCamera();
+	if (camera != nullptr)
+	{
+		m_cameraData.m_view = camera->GetViewMatrix();
+		m_cameraData.m_proj = m_projectionMatrix;
+		m_cameraData.m_viewProj = m_cameraData.m_proj * m_cameraData.m_view;
+		m_cameraData.m_invView = m_cameraData.m_view.Inverse();
+		m_cameraData.m_invProj = m_cameraData.m_proj.Inverse();
+		m_cameraData.m_invViewProj = m_cameraData.m_invView * m_cameraData.m_invProj;
+
+		m_renderList.Build(*m_GOF);
+	}
+
+	uint64_t tick = m_appPtr->GetSimulationTick();
+	float alpha = m_appPtr->GetInterpolationAlpha();
+	for (const RenderPackage& rp : m_renderList.GetPackages())
+	{
+		MeshBuffer buffer = {};
+		buffer.m_world = rp.m_sceneComponent->GetInterpolatedTransform(tick, alpha);
+		buffer.m_color = rp.m_graphicsComponent->m_material->m_color;
+		m_meshData.push_back(buffer);
+	}
+
+	ImGui::Render();	// closes the UI frame, draw data is dropped
+}
+
+void NullGraphicsSystem::Exit(void)
+{
+	for (std::pair<std::string, Material*> it : m_materials)
+	{
+		delete it.second;
+	}
+	m_materials.clear();
+
+	for (std::pair<std::string, Model*> it : m_models)
+	{
+		delete it.second;
+	}
+	m_models.clear();
+
+	m_worldManager = nullptr;
+}
+
+void NullGraphicsSystem::RegisterMessages(void)
+{
+	m_messenger.Subscribe<WindowResizeMessage>(this, &NullGraphicsSystem::OnWindowResize);
+	m_messenger.Subscribe<MaterialRequestMessage>(this, &NullGraphicsSystem::OnMaterialRequest);
+	m_messenger.Subscribe<ModelRequestMessage>(this, &NullGraphicsSystem::OnModelRequest);
+}
+
+void NullGraphicsSystem::RegisterComponents(void) const
+{
+	GraphicsComponent::Register();
+}
+
+void NullGraphicsSystem::DeclareAccess(SystemAccess& access) const
+{
+	access.m_writesAll = false;
+	access.m_mainThread = true;	// ImGui frame
+	if (access.m_writes.empty())
+	{
+		access.m_reads = { "GameObject", "SceneComponent", "GraphicsComponent", "Camera" };
+		access.m_writes = { "GraphicsResources" };
+	}
+}
+
+const RenderList& NullGraphicsSystem::GetRenderList(void) const
+{
+	return m_renderList;
+}
+
+void NullGraphicsSystem::OnWindowResize(const WindowResizeMessage& msg)
+{
+	m_projectionMatrix = Matrix::PerspectiveLH(msg.m_width, msg.m_height, 0.1f, 100.0f);
+}
+
+void NullGraphicsSystem::OnMaterialRequest(const MaterialRequestMessage& msg)
+{
+	std::map<std::string, Material*>::const_iterator iter = m_materials.find(msg.m_materialName);
+	if (iter != m_materials.end())
+	{
+		m_messenger.SendTo(msg.m_replyAddress, MaterialReadyMessage(iter->second));
+	}
+	else
+	{ // requester would wait for the reply forever
+		fprintf(stderr, "NullGraphicsSystem::%s: material \"%s\" not found\n", __func__, msg.m_materialName.c_str());
+		m_messenger.SendTo(msg.m_replyAddress, MaterialReadyMessage(nullptr));
+	}
+}
+
+void NullGraphicsSystem::OnModelRequest(const ModelRequestMessage& msg)
+{
+	std::map<std::string, Model*>::const_iterator iter = m_models.find(msg.m_modelName);
+	if (iter != m_models.end())
+	{
+		m_messenger.SendTo(msg.m_replyAddress, ModelReadyMessage(iter->second));
+	}
+	else
+	{
+		fprintf(stderr, "NullGraphicsSystem::%s: model \"%s\" not found\n", __func__, msg.m_modelName.c_str());
+		m_messenger.SendTo(msg.m_replyAddress, ModelReadyMessage(nullptr));
+	}
+}
+
+void NullGraphicsSystem::ReadMaterialData(const std::string& filePath)
+{
+	std::string matName = StringUtility::ExtractFilenameFromPath(filePath);
+	matName = StringUtility::RemoveFileExtension(matName);
+
+	if (m_materials.find(matName) != m_materials.end())
+	{
+		fprintf(stderr, "NullGraphicsSystem::%s: \"%s\" already exists\n", __func__, matName.c_str());
+		return;
+	}
+
+	JSONDoc* materialDoc = JSONUtility::ParseFile(filePath);
+	if (materialDoc == nullptr)
+	{
+		return;
+	}
+
+	JSONData materialData(materialDoc->MemberBegin());
+	if (materialData.IsValid())
+	{
+		Material* material = new Material;
+		material->Deserialize(materialData);
+		m_materials.insert({ matName, material });
+	}
+	else
+	{
+		fprintf(stderr, "NullGraphicsSystem::%s: file \"%s\" does not contain valid Material data\n",
+			__func__, StringUtility::ExtractFilenameFromPath(filePath).c_str());
+	}
+	delete materialDoc;
+}
+
+void NullGraphicsSystem::ReadModelData(const std::string& filePath)
+{
+	std::string modName = StringUtility::ExtractFilenameFromPath(filePath);
+	modName = StringUtility::RemoveFileExtension(modName);
+
+	if (m_models.find(modName) != m_models.end())
+	{
+		fprintf(stderr, "NullGraphicsSystem::%s: \"%s\" already exists\n", __func__, modName.c_str());
+		return;
+	}
+
+	JSONDoc* modelDoc = JSONUtility::ParseFile(filePath);
+	if (modelDoc == nullptr)
+	{
+		return;
+	}
+
+	JSONData modelData(modelDoc->MemberBegin());
+	if (modelData.IsValid())
+	{
+		Model* model = new Model;
+		model->Deserialize(modelData);
+		m_models.insert({ modName, model });
+	}
+	else
+	{
+		fprintf(stderr, "NullGraphicsSystem::%s: file \"%s\" does not contain valid Model data\n",
+			__func__, StringUtility::ExtractFilenameFromPath(filePath).c_str());
+	}
+	delete modelDoc;
+}
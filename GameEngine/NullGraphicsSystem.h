@@ -0,0 +1,76 @@
+// Copyright (C) 2023  Mantas Naujokas
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef NULLGRAPHICSSYSTEM_H
+#define NULLGRAPHICSSYSTEM_H
+
+#include "ISystem.h"
+#include "ConstantBuffers.h"
+#include "Matrix.h"
+#include "RenderList.h"
+#include <map>
+#include <string>
+#include <vector>
+
+class WorldManager;
+class Material;
+class Model;
+class WindowResizeMessage;
+class MaterialRequestMessage;
+class ModelRequestMessage;
+
+/* NullGraphicsSystem - graphics backend of headless runs. Loads materials and models, answers resource
+requests and builds render packages and their buffer data like GraphicsSystem, but makes no GPU calls */
+class NullGraphicsSystem : public ISystem
+{
+public:
+	NullGraphicsSystem(App* app, GameObjectFactory* GOF);
+	~NullGraphicsSystem(void);
+
+	bool Initialize(INIReader* ini) override final;
+	void Update(float deltaTime) override final;
+	void Exit(void) override final;
+	const char* GetName(void) const override final;
+
+	void RegisterMessages(void) override final;
+
+	void RegisterComponents(void) const override final;
+	void DeclareAccess(SystemAccess& access) const override final;
+
+	const RenderList& GetRenderList(void) const;
+
+private:
+	void OnWindowResize(const WindowResizeMessage& msg);
+	void OnMaterialRequest(const MaterialRequestMessage& msg);
+	void OnModelRequest(const ModelRequestMessage& msg);
+
+	void ReadMaterialData(const std::string& filePath);
+	void ReadModelData(const std::string& filePath);
+
+private:
+	Matrix m_projectionMatrix;
+
+	std::map<std::string, Material*> m_materials;	// textures are not loaded, materials keep a null texture
+	std::map<std::string, Model*> m_models;	// models keep a null vertex buffer
+	RenderList m_renderList;
+
+	/* Buffer data GraphicsSystem would upload this frame */
+	CameraBuffer m_cameraData;
+	std::vector<MeshBuffer> m_meshData;
+
+	WorldManager* m_worldManager; // used for getting the Camera pointer from the currently active world
+};
+
+#endif
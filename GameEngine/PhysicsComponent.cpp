@@ -14,6 +14,7 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "PhysicsComponent.h"
+#include "BinaryStream.h"
 #include "GameObjectFactory.h"
 #include "JSONData.h"
 #include "SceneComponent.h"
@@ -36,9 +37,17 @@ PhysicsComponent::PhysicsComponent(uint64_t id, GameObject* owner)
 	, m_colliderWeight(0.0f)
 {}
 
+PhysicsComponent::PhysicsComponent(const PhysicsComponent& rhs)
+	: Component(rhs)
+	, m_collider(CopyCollider(rhs.m_collider))
+	, m_colliderWeight(rhs.m_colliderWeight)
+	, m_velocity(rhs.m_velocity)
+	, m_collisions(rhs.m_collisions)
+{}
+
 PhysicsComponent::~PhysicsComponent(void)
 {
-	delete m_collider;
+	GameObjectFactory::Get()->DestroyInStorage(m_collider);
 }
 
 Shape& PhysicsComponent::GetColliderShape(void) const
@@ -100,7 +109,7 @@ void PhysicsComponent::Deserialize(const JSONData& source)
 		shapeType = m_collider->m_typeStr;
 		hasTypeData = true;
 
-		delete m_collider;
+		GameObjectFactory::Get()->DestroyInStorage(m_collider);
 		m_collider = nullptr;
 	}
 	else
@@ -110,39 +119,7 @@ void PhysicsComponent::Deserialize(const JSONData& source)
 
 	if (hasTypeData)
 	{
-		std::vector<SceneComponent*> sceneComps;
-		GetOwner()->QueryComponents(sceneComps);
-		if (!sceneComps.empty())
-		{
-			Transform& transform = sceneComps[0]->GetTransform();
-
-			Vector2 halfExtents = { transform.GetScale().x * 0.5f, transform.GetScale().y * 0.5f };
-
-			if (shapeType == "Point")
-			{
-				m_collider = new Point(transform.GetPosition());
-			}
-			else if (shapeType == "Circle")
-			{
-				m_collider = new Circle(transform.GetPosition(), halfExtents.x);
-			}
-			else if (shapeType == "AABB")
-			{
-				m_collider = new AABB(transform.GetPosition(), halfExtents);
-			}
-			else if (shapeType == "OBB")
-			{
-				m_collider = new OBB(transform.GetPosition(), halfExtents, transform.GetRotation().z);
-			}
-			else
-			{
-				fprintf(stderr, "PhysicsComponent::%s: unknown shape type \"%s\"\n", __func__, shapeType.c_str());
-			}
-		}
-		else
-		{
-			fprintf(stderr, "%s::PhysicsComponent::%s: no valid SceneComponent found\n", GetOwner()->GetObjectTypeName().c_str(), __func__);
-		}
+		CreateCollider(shapeType);
 	}
 	else
 	{
@@ -157,12 +134,93 @@ void PhysicsComponent::Deserialize(const JSONData& source)
 	}
 }
 
+void PhysicsComponent::WriteBinary(BinaryWriter& writer) const
+{
+	writer.WriteString(m_collider != nullptr ? m_collider->m_typeStr : "");
+	writer.Write(m_colliderWeight);
+}
+
+void PhysicsComponent::ReadBinary(BinaryReader& reader)
+{
+	std::string shapeType;
+	reader.ReadString(shapeType);
+	reader.Read(m_colliderWeight);
+
+	GameObjectFactory::Get()->DestroyInStorage(m_collider);
+	m_collider = nullptr;
+	if (!shapeType.empty())
+	{
+		CreateCollider(shapeType);
+	}
+}
+
 Component* PhysicsComponent::Clone(void) const
 {
 	Component* clone = new PhysicsComponent(*this);
 	return clone;
 }
 
+void PhysicsComponent::CreateCollider(const std::string& shapeType)
+{
+	std::vector<const SceneComponent*> sceneComps;
+	GetOwner()->QueryComponents(sceneComps);
+	if (sceneComps.empty())
+	{
+		fprintf(stderr, "%s::PhysicsComponent::%s: no valid SceneComponent found\n", GetOwner()->GetObjectTypeName().c_str(), __func__);
+		return;
+	}
+
+	GameObjectFactory* GOF = GameObjectFactory::Get();
+	const Transform& transform = sceneComps[0]->GetTransform();
+
+	Vector2 halfExtents = { transform.GetScale().x * 0.5f, transform.GetScale().y * 0.5f };
+
+	if (shapeType == "Point")
+	{
+		m_collider = GOF->ConstructInStorage<Point>(transform.GetPosition());
+	}
+	else if (shapeType == "Circle")
+	{
+		m_collider = GOF->ConstructInStorage<Circle>(transform.GetPosition(), halfExtents.x);
+	}
+	else if (shapeType == "AABB")
+	{
+		m_collider = GOF->ConstructInStorage<AABB>(transform.GetPosition(), halfExtents);
+	}
+	else if (shapeType == "OBB")
+	{
+		m_collider = GOF->ConstructInStorage<OBB>(transform.GetPosition(), halfExtents, transform.GetRotation().z);
+	}
+	else
+	{
+		fprintf(stderr, "PhysicsComponent::%s: unknown shape type \"%s\"\n", __func__, shapeType.c_str());
+	}
+}
+
+Shape* PhysicsComponent::CopyCollider(const Shape* source)
+{
+	if (source == nullptr)
+	{
+		return nullptr;
+	}
+
+	GameObjectFactory* GOF = GameObjectFactory::Get();
+	switch (source->m_type)
+	{
+	case ShapeType::Point:
+		return GOF->ConstructInStorage<Point>(*static_cast<const Point*>(source));
+	case ShapeType::Circle:
+		return GOF->ConstructInStorage<Circle>(*static_cast<const Circle*>(source));
+	case ShapeType::AABB:
+		return GOF->ConstructInStorage<AABB>(*static_cast<const AABB*>(source));
+	case ShapeType::OBB:
+		return GOF->ConstructInStorage<OBB>(*static_cast<const OBB*>(source));
+	default:
+		fprintf(stderr, "PhysicsComponent::%s: unknown shape type \"%s\"\n", __func__, source->m_typeStr.c_str());
+		return nullptr;
+	}
+}
+
 const std::string& PhysicsComponent::GetObjectTypeName(void) const
 {
 	return GetClassTypeName();
@@ -28,7 +28,7 @@ public:
 
 	PhysicsComponent(void);
 	PhysicsComponent(uint64_t id, GameObject* owner);
-	PhysicsComponent(const PhysicsComponent& rhs) = default;
+	PhysicsComponent(const PhysicsComponent& rhs);
 	~PhysicsComponent(void);
 
 	Shape& GetColliderShape(void) const;
@@ -46,6 +46,8 @@ public:
 	const Vector3& GetLastPosition(void) const;
 
 	void Deserialize(const JSONData& source) override;
+	void WriteBinary(BinaryWriter& writer) const override;
+	void ReadBinary(BinaryReader& reader) override;
 
 	Component* Clone(void) const override;
 
@@ -54,6 +56,11 @@ public:
 
 	void NotifyCollision(void);
 
+private:
+	// CreateCollider: builds collider of shapeType from owner's SceneComponent transform
+	void CreateCollider(const std::string& shapeType);
+	static Shape* CopyCollider(const Shape* source);
+
 private:
 	Shape* m_collider;
 	float m_colliderWeight; // heavier objects do not move when colliding with lighter objects, 0.0 means the object will not collide (ghost)
@@ -21,8 +21,11 @@
 #include "PhysicsComponent.h"
 #include "SceneComponent.h"
 #include "Collision.h"
+#include "Profiler.h"
 #include <math.h>
 
+static const size_t PhysicsJobGrainSize = 64U;	// components per job when updating in parallel
+
 namespace PhysicsDebug
 {
 	void PrintCollisionData(const PhysicsComponent* physComp, const Shape* colliderShape, const Collision::ShapeCollision* collision)
@@ -42,6 +45,7 @@ namespace PhysicsDebug
 
 PhysicsSystem::PhysicsSystem(App* app, GameObjectFactory* GOF)
 	: ISystem(app, GOF)
+	, m_listVersion(UINT64_MAX)
 {}
 
 PhysicsSystem::~PhysicsSystem(void)
@@ -54,124 +58,91 @@ bool PhysicsSystem::Initialize(INIReader* ini)
 	return true;
 }
 
+const char* PhysicsSystem::GetName(void) const
+{
+	return "PhysicsSystem";
+}
+
 void PhysicsSystem::Update(float deltaTime)
 {
-	if (m_appPtr->m_appStateIsRunning)
+	/* Lists are rebuilt only when objects are created, destroyed, woken or put to sleep */
+	uint64_t listVersion = m_GOF->GetObjectListVersion();
+	bool listsChanged = listVersion != m_listVersion;
+	if (listsChanged)
 	{
-		m_GOF->GetComponentsOfType(m_physicsComponents);
-	}
-	else
-	{
-		m_physicsComponents.clear();
+		RebuildLists();
+		m_listVersion = listVersion;
 	}
 
-	if (!m_physicsComponents.empty())
+	if (m_appPtr->m_appStateIsRunning && !m_dynamicComponents.empty())
 	{
-		size_t numComps = m_physicsComponents.size();
+		size_t numDynamic = m_dynamicComponents.size();
 
-		for (size_t i = 0U; i < numComps; ++i)
 		{
-			PhysicsComponent* physicsComponent = m_physicsComponents[i];
+			PROFILE_SCOPE("PhysicsSystem::Integrate");
+			m_appPtr->GetJobSystem().ParallelFor(numDynamic, PhysicsJobGrainSize, [this](size_t begin, size_t end)
+				{
+					for (size_t i = begin; i < end; ++i)
+					{
+						PhysicsComponent* physicsComponent = m_dynamicComponents[i];
 
-			Shape& colliderShape = physicsComponent->GetColliderShape();
-			colliderShape.m_previousCenter = colliderShape.m_center;
-			colliderShape.m_center += physicsComponent->GetVelocity();
+						Shape& colliderShape = physicsComponent->GetColliderShape();
+						colliderShape.m_previousCenter = colliderShape.m_center;
+						colliderShape.m_center += physicsComponent->GetVelocity();
+					}
+				});
 		}
 
-		for (size_t i = 0U; i < numComps - 1U; ++i)
+		/* Dynamic pairs, then dynamic against static. Static pairs never collide */
 		{
-			PhysicsComponent* aPhysComp = m_physicsComponents[i];
-			Shape& aColliderShape = aPhysComp->GetColliderShape();
-
-			for (size_t j = i + 1U; j < numComps; ++j)
+			PROFILE_SCOPE("PhysicsSystem::Broadphase");
+			for (size_t i = 0U; i < numDynamic; ++i)
 			{
-				PhysicsComponent* bPhysComp = m_physicsComponents[j];
-				Shape& bColliderShape = bPhysComp->GetColliderShape();
+				PhysicsComponent* aPhysComp = m_dynamicComponents[i];
 
-				if (aPhysComp->GetColliderWeight() != 0.0f && bPhysComp->GetColliderWeight() != 0.0f)
-				{ // skip collision processing if any of the objects has 0.0 collider weight
-					Collision::CollisionResult collision = Collision::IsCollision(aColliderShape, bColliderShape);
+				for (size_t j = i + 1U; j < numDynamic; ++j)
+				{
+					PhysicsComponent* bPhysComp = m_dynamicComponents[j];
+					if (!ResolveCollision(aPhysComp, bPhysComp))
+					{
+						return;
+					}
+
+					std::vector<SceneComponent*> sceneComp;
+					bPhysComp->GetOwner()->QueryComponents<SceneComponent>(sceneComp);
+					Transform& t = sceneComp[0]->GetTransform();
+					t.SetPosition(bPhysComp->GetColliderShape().m_center);
+				}
 
-					if (collision.A.isCollision || collision.B.isCollision)
+				for (PhysicsComponent* staticPhysComp : m_staticComponents)
+				{
+					if (!ResolveCollision(aPhysComp, staticPhysComp))
 					{
-						bool isAMoved = aColliderShape.m_center != aColliderShape.m_previousCenter;
-						bool isBMoved = bColliderShape.m_center != bColliderShape.m_previousCenter;
-
-						PhysicsComponent* adjustablePhysComp = nullptr;
-						Shape* adjustableShape = nullptr;
-						Collision::CollisionEvent* activeCollisionEvent = nullptr;
-
-						if (isAMoved && isBMoved)
-						{
-							// adjust lighter object relative to heavier object
-							// in case objects are equal, adjust second object relative to first
-							if (aPhysComp->GetColliderWeight() < bPhysComp->GetColliderWeight())
-							{
-								adjustablePhysComp = aPhysComp;
-								adjustableShape = &aColliderShape;
-								activeCollisionEvent = &collision.A;
-							}
-							else
-							{
-								adjustablePhysComp = bPhysComp;
-								adjustableShape = &bColliderShape;
-								activeCollisionEvent = &collision.B;
-							}
-						}
-						else if (isAMoved)
-						{
-							adjustablePhysComp = aPhysComp;
-							adjustableShape = &aColliderShape;
-							activeCollisionEvent = &collision.A;
-						}
-						else if (isBMoved)
-						{
-							adjustablePhysComp = bPhysComp;
-							adjustableShape = &bColliderShape;
-							activeCollisionEvent = &collision.B;
-						}
-
-						if (adjustablePhysComp != nullptr && adjustableShape != nullptr && activeCollisionEvent != nullptr)
-						{
-							PhysicsDebug::PrintCollisionData(adjustablePhysComp, adjustableShape, &activeCollisionEvent->thisShape);
-
-							adjustableShape->m_center = adjustableShape->m_previousCenter + adjustablePhysComp->GetVelocity() * activeCollisionEvent->thisShape.m_time;
-							adjustablePhysComp->AddCollision(activeCollisionEvent->collidingShape.m_normal);
-						}
-						else
-						{
-							std::string failed;
-							if (adjustablePhysComp == nullptr) { failed += "adjustablePhysComp, "; }
-							if (adjustableShape == nullptr) { failed += "adjustableShape, "; }
-							if (activeCollisionEvent == nullptr) { failed += "activeCollisionEvent"; }
-							fprintf(stderr, "PhysicsSystem::%s: could not resolve collision. %s == nullptr\n", __func__, failed.c_str());
-							return;
-						}
-
-						aPhysComp->NotifyCollision();
-						bPhysComp->NotifyCollision();
+						return;
 					}
 				}
 
 				std::vector<SceneComponent*> sceneComp;
-				bPhysComp->GetOwner()->QueryComponents<SceneComponent>(sceneComp);
+				aPhysComp->GetOwner()->QueryComponents(sceneComp);
 				Transform& t = sceneComp[0]->GetTransform();
-				t.SetPosition(bColliderShape.m_center);
+				t.SetPosition(aPhysComp->GetColliderShape().m_center);
 			}
-
-			std::vector<SceneComponent*> sceneComp;
-			aPhysComp->GetOwner()->QueryComponents(sceneComp);
-			Transform& t = sceneComp[0]->GetTransform();
-			t.SetPosition(aColliderShape.m_center);
 		}
 	}
 
-	m_GOF->GetComponentsOfType(m_sceneComponents);
-	for (SceneComponent* sceneComponent : m_sceneComponents)
-	{
-		Matrix transformMatrix = AssembleNewMatrix(sceneComponent, deltaTime);
-		sceneComponent->SetTransform(transformMatrix);
-	}
+	/* Matrices only read positions, rotations and scales, so components can be assembled in any order.
+	Dormant objects do not move, their matrices are assembled only when lists change */
+	std::vector<SceneComponent*>& sceneComponents = listsChanged ? m_sceneComponents : m_awakeSceneComponents;
+	uint64_t tick = m_appPtr->GetSimulationTick();
+	m_appPtr->GetJobSystem().ParallelFor(sceneComponents.size(), PhysicsJobGrainSize, [this, &sceneComponents, deltaTime, tick](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				SceneComponent* sceneComponent = sceneComponents[i];
+				Matrix transformMatrix = AssembleNewMatrix(sceneComponent, deltaTime);
+				sceneComponent->SetTransform(transformMatrix, tick);
+			}
+		});
 }
 
 void PhysicsSystem::Exit(void)
@@ -195,6 +166,122 @@ void PhysicsSystem::RegisterComponents(void) const
 	SceneComponent::Register();
 }
 
+void PhysicsSystem::DeclareAccess(SystemAccess& access) const
+{
+	access.m_writesAll = false;
+	access.m_mainThread = false;
+	access.m_simulation = true;
+	if (access.m_writes.empty())
+	{ /* Collision reactions run on the physics worker and change their objects' state and graphics,
+		e.g. brick lives and material color */
+		access.m_writes = { "PhysicsComponent", "SceneComponent", "GameObject", "GraphicsComponent" };
+	}
+}
+
+void PhysicsSystem::RebuildLists(void)
+{
+	m_GOF->GetComponentsOfType(m_physicsComponents);
+	m_dynamicComponents.clear();
+	m_staticComponents.clear();
+	for (PhysicsComponent* physicsComponent : m_physicsComponents)
+	{
+		if (physicsComponent->IsDormant())
+		{
+			m_staticComponents.push_back(physicsComponent);
+		}
+		else
+		{
+			m_dynamicComponents.push_back(physicsComponent);
+		}
+	}
+
+	m_GOF->GetComponentsOfType(m_sceneComponents);
+	m_awakeSceneComponents.clear();
+	for (SceneComponent* sceneComponent : m_sceneComponents)
+	{
+		if (!sceneComponent->IsDormant())
+		{
+			m_awakeSceneComponents.push_back(sceneComponent);
+		}
+	}
+}
+
+bool PhysicsSystem::ResolveCollision(PhysicsComponent* aPhysComp, PhysicsComponent* bPhysComp) const
+{
+	Shape& aColliderShape = aPhysComp->GetColliderShape();
+	Shape& bColliderShape = bPhysComp->GetColliderShape();
+
+	if (aPhysComp->GetColliderWeight() != 0.0f && bPhysComp->GetColliderWeight() != 0.0f)
+	{ // skip collision processing if any of the objects has 0.0 collider weight
+		Collision::CollisionResult collision = Collision::IsCollision(aColliderShape, bColliderShape);
+
+		if (collision.A.isCollision || collision.B.isCollision)
+		{
+			PROFILE_SCOPE("PhysicsSystem::Narrowphase");	// overlapping pairs only, a scope per tested pair costs more than the test
+			bool isAMoved = aColliderShape.m_center != aColliderShape.m_previousCenter;
+			bool isBMoved = bColliderShape.m_center != bColliderShape.m_previousCenter;
+
+			PhysicsComponent* adjustablePhysComp = nullptr;
+			Shape* adjustableShape = nullptr;
+			Collision::CollisionEvent* activeCollisionEvent = nullptr;
+
+			if (isAMoved && isBMoved)
+			{
+				// adjust lighter object relative to heavier object
+				// in case objects are equal, adjust second object relative to first
+				if (aPhysComp->GetColliderWeight() < bPhysComp->GetColliderWeight())
+				{
+					adjustablePhysComp = aPhysComp;
+					adjustableShape = &aColliderShape;
+					activeCollisionEvent = &collision.A;
+				}
+				else
+				{
+					adjustablePhysComp = bPhysComp;
+					adjustableShape = &bColliderShape;
+					activeCollisionEvent = &collision.B;
+				}
+			}
+			else if (isAMoved)
+			{
+				adjustablePhysComp = aPhysComp;
+				adjustableShape = &aColliderShape;
+				activeCollisionEvent = &collision.A;
+			}
+			else if (isBMoved)
+			{
+				adjustablePhysComp = bPhysComp;
+				adjustableShape = &bColliderShape;
+				activeCollisionEvent = &collision.B;
+			}
+
+			if (adjustablePhysComp != nullptr && adjustableShape != nullptr && activeCollisionEvent != nullptr)
+			{
+				PhysicsDebug::PrintCollisionData(adjustablePhysComp, adjustableShape, &activeCollisionEvent->thisShape);
+
+				adjustableShape->m_center = adjustableShape->m_previousCenter + adjustablePhysComp->GetVelocity() * activeCollisionEvent->thisShape.m_time;
+				adjustablePhysComp->AddCollision(activeCollisionEvent->collidingShape.m_normal);
+			}
+			else
+			{
+				std::string failed;
+				if (adjustablePhysComp == nullptr) { failed += "adjustablePhysComp, "; }
+				if (adjustableShape == nullptr) { failed += "adjustableShape, "; }
+				if (activeCollisionEvent == nullptr) { failed += "activeCollisionEvent"; }
+				fprintf(stderr, "PhysicsSystem::%s: could not resolve collision. %s == nullptr\n", __func__, failed.c_str());
+				return false;
+			}
+
+			/* Struck dormant objects react but stay dormant, they are static colliders and
+			nothing would put them back to sleep. Objects that start moving on a hit wake themselves */
+			aPhysComp->NotifyCollision();
+			bPhysComp->NotifyCollision();
+		}
+	}
+
+	return true;
+}
+
 Matrix PhysicsSystem::AssembleNewMatrix(const SceneComponent* sourceScene, float deltaTime,
 	bool omitParentScale, bool omitParentRotation, bool omitParentPosition) const
 {
@@ -33,19 +33,28 @@ public:
 	bool Initialize(INIReader* ini) override final;
 	void Update(float deltaTime) override final;
 	void Exit(void) override final;
+	const char* GetName(void) const override final;
 
 	void RegisterMessages(void);
 	void ProcessMessage(const Message* message) override final;
 
 	void RegisterComponents(void) const override final;
+	void DeclareAccess(SystemAccess& access) const override final;
 
 private:
+	void RebuildLists(void);	// splits components into dynamic and dormant (static) lists
+	// ResolveCollision: moves the object that moved into the other one back, false if collision could not be resolved
+	bool ResolveCollision(PhysicsComponent* aPhysComp, PhysicsComponent* bPhysComp) const;
 	Matrix AssembleNewMatrix(const SceneComponent* sourceScene, float deltaTime,
 		bool omitParentScale = false, bool omitParentRotation = false, bool omitParentPosition = false) const;
 
 private:
 	std::vector<PhysicsComponent*> m_physicsComponents;
+	std::vector<PhysicsComponent*> m_dynamicComponents;	// integrated and collided every frame
+	std::vector<PhysicsComponent*> m_staticComponents;	// dormant, only collided against
 	std::vector<SceneComponent*> m_sceneComponents;
+	std::vector<SceneComponent*> m_awakeSceneComponents;
+	uint64_t m_listVersion;	// object list version the lists were built for
 };
 
 #endif
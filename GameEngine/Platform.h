@@ -0,0 +1,35 @@
+// Copyright (C) 2023  Mantas Naujokas
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+/* PLATFORM_WIN32 - window, Win32 input and D3D11 rendering are available.
+Other platforms build the engine core only and run headless */
+#ifdef _WIN32
+#define PLATFORM_WIN32 1
+#else
+#define PLATFORM_WIN32 0
+#endif
+
+// Stop in the attached debugger
+#if PLATFORM_WIN32
+#define DEBUG_BREAK() __debugbreak()
+#else
+#include <signal.h>
+#define DEBUG_BREAK() raise(SIGTRAP)
+#endif
+
+#endif
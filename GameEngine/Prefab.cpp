@@ -0,0 +1,150 @@
+// Copyright (C) 2023  Mantas Naujokas
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Prefab.h"
+#include "BinaryStream.h"
+#include <fstream>
+#include <iterator>
+#include <stdio.h>
+
+Prefab::Prefab(void)
+	: m_sourceHash(0U)
+	, m_objectDataSize(0U)
+{}
+
+bool Prefab::Save(const std::string& path) const
+{
+	std::vector<uint8_t> buffer;
+	BinaryWriter writer(buffer);
+
+	writer.Write(FILE_MAGIC);
+	writer.Write(FILE_VERSION);
+	writer.Write(m_sourceHash);
+	writer.WriteString(m_type);
+	writer.Write(static_cast<uint64_t>(m_objectDataSize));
+	writer.Write(static_cast<uint32_t>(m_components.size()));
+	for (const ComponentRecord& record : m_components)
+	{
+		writer.WriteString(record.m_type);
+		writer.Write(static_cast<uint64_t>(record.m_offset));
+		writer.Write(static_cast<uint64_t>(record.m_size));
+	}
+	writer.Write(static_cast<uint64_t>(m_data.size()));
+	writer.WriteBytes(m_data.data(), m_data.size());
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+	{
+		fprintf(stderr, "Prefab::%s: cannot open \"%s\" for writing\n", __func__, path.c_str());
+		return false;
+	}
+	file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+	return file.good();
+}
+
+bool Prefab::Load(const std::string& path, uint64_t expectedHash)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file.is_open())
+	{
+		return false;
+	}
+	std::vector<uint8_t> buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	BinaryReader reader(buffer.data(), buffer.size());
+	uint32_t magic = 0U;
+	uint32_t version = 0U;
+	reader.Read(magic);
+	reader.Read(version);
+	reader.Read(m_sourceHash);
+	if (!reader.IsValid() || magic != FILE_MAGIC || version != FILE_VERSION || m_sourceHash != expectedHash)
+	{ // outdated cache, prefab gets compiled again
+		return false;
+	}
+
+	uint64_t objectDataSize = 0U;
+	uint32_t numComponents = 0U;
+	reader.ReadString(m_type);
+	reader.Read(objectDataSize);
+	reader.Read(numComponents);
+	m_objectDataSize = static_cast<size_t>(objectDataSize);
+
+	m_components.clear();
+	for (uint32_t i = 0U; i < numComponents && reader.IsValid(); ++i)
+	{
+		ComponentRecord record = { "", nullptr, 0U, 0U };
+		uint64_t offset = 0U;
+		uint64_t size = 0U;
+		reader.ReadString(record.m_type);
+		reader.Read(offset);
+		reader.Read(size);
+		record.m_offset = static_cast<size_t>(offset);
+		record.m_size = static_cast<size_t>(size);
+		m_components.push_back(record);
+	}
+
+	uint64_t dataSize = 0U;
+	reader.Read(dataSize);
+	m_data.resize(static_cast<size_t>(dataSize));
+	reader.ReadBytes(m_data.data(), m_data.size());
+
+	if (!reader.IsValid())
+	{
+		fprintf(stderr, "Prefab::%s: \"%s\" is corrupted\n", __func__, path.c_str());
+		return false;
+	}
+
+	/* Component data has to lie within the buffer */
+	if (m_objectDataSize > m_data.size())
+	{
+		fprintf(stderr, "Prefab::%s: \"%s\" is corrupted\n", __func__, path.c_str());
+		return false;
+	}
+	for (const ComponentRecord& record : m_components)
+	{
+		if (record.m_offset > m_data.size() || record.m_size > m_data.size() - record.m_offset)
+		{
+			fprintf(stderr, "Prefab::%s: \"%s\" is corrupted\n", __func__, path.c_str());
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool Prefab::HashFile(const std::string& path, uint64_t& hash)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	std::vector<char> buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	hash = Hash(buffer.data(), buffer.size());
+	return true;
+}
+
+uint64_t Prefab::Hash(const void* data, size_t size)
+{
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	uint64_t hash = 14695981039346656037ULL;
+	for (size_t i = 0U; i < size; ++i)
+	{
+		hash ^= bytes[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
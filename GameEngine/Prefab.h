@@ -0,0 +1,59 @@
+// Copyright (C) 2023  Mantas Naujokas
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef PREFAB_H
+#define PREFAB_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class Component;
+
+/* Prefab - compiled form of a .go archetype. Holds pre-parsed field values of the object and
+its components back to back in one buffer, instances are created by reading them back */
+class Prefab
+{
+public:
+	struct ComponentRecord
+	{
+		std::string m_type;
+		const Component* m_prototype;	// resolved from GameObjectFactory register, not saved
+		size_t m_offset;	// start of component data in m_data
+		size_t m_size;
+	};
+
+	Prefab(void);
+
+	// Save/Load: cache file stores source hash, loading fails if it does not match expectedHash
+	bool Save(const std::string& path) const;
+	bool Load(const std::string& path, uint64_t expectedHash);
+
+	// Hash: FNV-1a hash of data
+	static uint64_t Hash(const void* data, size_t size);
+	static bool HashFile(const std::string& path, uint64_t& hash);
+
+public:
+	std::string m_type;
+	uint64_t m_sourceHash;	// hash of the .go file the prefab was compiled from
+	std::vector<uint8_t> m_data;
+	size_t m_objectDataSize;	// object's own data is at the start of m_data
+	std::vector<ComponentRecord> m_components;
+
+	static constexpr uint32_t FILE_MAGIC = 0x42414650U;	// "PFAB"
+	static constexpr uint32_t FILE_VERSION = 1U;	// increase when Write/ReadBinary data layout changes
+};
+
+#endif
@@ -0,0 +1,352 @@
+// Copyright (C) 2023  Mantas Naujokas
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Profiler.h"
+#include "JobSystem.h"
+#include <imgui.h>
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+
+static Profiler* gProfilerPtr = nullptr;
+static const std::chrono::steady_clock::time_point gStartTime = std::chrono::steady_clock::now();
+
+static thread_local uint32_t tDepth = 0U;
+static thread_local const Profiler* tBufferOwner = nullptr;
+static thread_local void* tBuffer = nullptr;
+
+static const float FLAME_ROW_HEIGHT = 18.0f;
+
+// NameHue: scopes with the same name get the same color
+static float NameHue(const char* name)
+{
+	uint32_t hash = 2166136261U;	// FNV-1a
+	for (const char* c = name; *c != '\0'; ++c)
+	{
+		hash = (hash ^ static_cast<uint8_t>(*c)) * 16777619U;
+	}
+	return static_cast<float>(hash % 360U) / 360.0f;
+}
+
+ProfileScope::ProfileScope(const char* name)
+	: m_name(name)
+	, m_start(Profiler::Now())
+{
+	++tDepth;
+}
+
+ProfileScope::~ProfileScope(void)
+{
+	--tDepth;
+	if (gProfilerPtr != nullptr)
+	{
+		ProfileEvent event = { m_name, m_start, Profiler::Now(), tDepth, 0U };
+		gProfilerPtr->Record(event);
+	}
+}
+
+Profiler::Profiler(void)
+	: Singleton(this)
+	, m_lostEvents(0U)
+	, m_history(HistorySize)
+	, m_frameIndex(0U)
+	, m_frameStart(0U)
+	, m_lastStoredFrame(0U)
+	, m_paused(false)
+	, m_viewedFrame(0)
+	, m_captureFrames(60)
+	, m_traceFirstFrame(0U)
+	, m_traceLastFrame(0U)
+	, m_tracing(false)
+{
+	gProfilerPtr = this;
+}
+
+Profiler::~Profiler(void)
+{
+	StopTrace();
+	gProfilerPtr = nullptr;
+
+	for (ThreadBuffer* buffer : m_threadBuffers)
+	{
+		delete buffer;
+	}
+}
+
+void Profiler::BeginFrame(void)
+{
+	m_frameStart = Now();
+}
+
+void Profiler::EndFrame(void)
+{
+	m_frameEvents.clear();
+	CollectEvents(m_frameEvents);
+
+	ProfileFrame frame;
+	frame.m_index = m_frameIndex;
+	frame.m_start = m_frameStart;
+	frame.m_end = Now();
+
+	if (m_tracing && m_frameIndex >= m_traceFirstFrame)
+	{
+		m_traceFrames.push_back(frame);
+		m_traceFrames.back().m_events = m_frameEvents;
+		if (m_traceLastFrame != 0U && m_frameIndex >= m_traceLastFrame)
+		{
+			StopTrace();
+		}
+	}
+
+	if (!m_paused)
+	{ // reuses the storage of the frame it replaces
+		ProfileFrame& stored = m_history[m_frameIndex % HistorySize];
+		stored.m_index = frame.m_index;
+		stored.m_start = frame.m_start;
+		stored.m_end = frame.m_end;
+		stored.m_events.swap(m_frameEvents);
+		m_lastStoredFrame = m_frameIndex;
+	}
+
+	++m_frameIndex;
+}
+
+void Profiler::StartTrace(const std::string& path, uint64_t firstFrame, uint64_t lastFrame)
+{
+	StopTrace();
+
+	m_tracePath = path;
+	m_traceFirstFrame = firstFrame;
+	m_traceLastFrame = lastFrame;
+	m_tracing = true;
+}
+
+void Profiler::StopTrace(void)
+{
+	if (!m_tracing)
+	{
+		return;
+	}
+
+	m_tracing = false;
+	if (!m_traceFrames.empty())
+	{
+		WriteTrace();
+	}
+	m_traceFrames.clear();
+}
+
+uint64_t Profiler::GetFrameIndex(void) const
+{
+	return m_frameIndex;
+}
+
+void Profiler::Record(const ProfileEvent& event)
+{
+	ThreadBuffer* buffer = static_cast<ThreadBuffer*>(tBuffer);
+	if (tBufferOwner != this)
+	{
+		buffer = RegisterThread();
+	}
+
+	/* Only this thread writes the buffer, the slot is filled before the new count is published */
+	uint64_t written = buffer->m_written.load(std::memory_order_relaxed);
+	ProfileEvent& slot = buffer->m_events[written % ThreadBufferSize];
+	slot = event;
+	slot.m_thread = buffer->m_thread;
+	buffer->m_written.store(written + 1U, std::memory_order_release);
+}
+
+uint64_t Profiler::Now(void)
+{
+	std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - gStartTime;
+	return static_cast<uint64_t>(elapsed.count());
+}
+
+Profiler::ThreadBuffer* Profiler::RegisterThread(void)
+{
+	ThreadBuffer* buffer = new ThreadBuffer();
+	buffer->m_thread = JobSystem::GetThreadIndex();
+	{
+		std::lock_guard<std::mutex> lock(m_threadBuffersMutex);
+		m_threadBuffers.push_back(buffer);
+	}
+
+	tBufferOwner = this;
+	tBuffer = buffer;
+	return buffer;
+}
+
+void Profiler::CollectEvents(std::vector<ProfileEvent>& events)
+{
+	std::lock_guard<std::mutex> lock(m_threadBuffersMutex);
+	for (ThreadBuffer* buffer : m_threadBuffers)
+	{
+		uint64_t written = buffer->m_written.load(std::memory_order_acquire);
+		if (written - buffer->m_read > ThreadBufferSize)
+		{ // oldest events were overwritten
+			m_lostEvents += written - buffer->m_read - ThreadBufferSize;
+			buffer->m_read = written - ThreadBufferSize;
+		}
+
+		for (uint64_t i = buffer->m_read; i < written; ++i)
+		{
+			events.push_back(buffer->m_events[i % ThreadBufferSize]);
+		}
+		buffer->m_read = written;
+	}
+}
+
+bool Profiler::WriteTrace(void) const
+{
+	FILE* fp = fopen(m_tracePath.c_str(), "w");
+	if (fp == nullptr)
+	{
+		fprintf(stderr, "Profiler::%s: failed to open \"%s\"\n", __func__, m_tracePath.c_str());
+		return false;
+	}
+
+	/* Chrome trace event format: complete events with microsecond times, one tid per job system thread */
+	std::vector<uint32_t> threads;
+	fprintf(fp, "{\"traceEvents\":[\n");
+	for (const ProfileFrame& frame : m_traceFrames)
+	{
+		fprintf(fp, "{\"name\":\"Frame %llu\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":%.3f,\"dur\":%.3f},\n",
+			static_cast<unsigned long long>(frame.m_index), frame.m_start / 1000.0, (frame.m_end - frame.m_start) / 1000.0);
+
+		for (const ProfileEvent& event : frame.m_events)
+		{
+			fprintf(fp, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f},\n",
+				event.m_name, event.m_thread, event.m_start / 1000.0, (event.m_end - event.m_start) / 1000.0);
+
+			if (std::find(threads.begin(), threads.end(), event.m_thread) == threads.end())
+			{
+				threads.push_back(event.m_thread);
+			}
+		}
+	}
+
+	for (uint32_t thread : threads)
+	{
+		if (thread == 0U)
+		{
+			fprintf(fp, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"Main\"}},\n");
+		}
+		else
+		{
+			fprintf(fp, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"Worker %u\"}},\n", thread, thread);
+		}
+	}
+	fprintf(fp, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"App\"}}\n");
+	fprintf(fp, "],\"displayTimeUnit\":\"ms\"}\n");
+
+	fclose(fp);
+	printf("Profiler::%s: %zu frames written to \"%s\"\n", __func__, m_traceFrames.size(), m_tracePath.c_str());
+	return true;
+}
+
+void Profiler::ShowFlameGraph(void)
+{
+	ImGui::Begin("Profiler");
+
+	ImGui::Checkbox("Pause", &m_paused);
+	ImGui::SameLine();
+	ImGui::SliderInt("Frames back", &m_viewedFrame, 0, static_cast<int>(HistorySize) - 1);
+
+	ImGui::InputInt("Frames", &m_captureFrames);
+	m_captureFrames = std::max(m_captureFrames, 1);
+	ImGui::SameLine();
+	if (m_tracing)
+	{
+		ImGui::TextUnformatted("Tracing...");
+	}
+	else if (ImGui::Button("Capture trace"))
+	{
+		std::string path = m_tracePath.empty() ? "Trace.json" : m_tracePath;
+		StartTrace(path, m_frameIndex, m_frameIndex + static_cast<uint64_t>(m_captureFrames) - 1U);
+	}
+
+	/* While paused the history holds the frames up to the pause */
+	uint64_t viewedFrame = static_cast<uint64_t>(m_viewedFrame);
+	uint64_t viewedIndex = m_lastStoredFrame >= viewedFrame ? m_lastStoredFrame - viewedFrame : 0U;
+	const ProfileFrame& frame = m_history[viewedIndex % HistorySize];
+	if (frame.m_index != viewedIndex || frame.m_end <= frame.m_start)
+	{
+		ImGui::TextUnformatted("No frame recorded");
+		ImGui::End();
+		return;
+	}
+
+	double frameTime = (frame.m_end - frame.m_start) / 1000000.0;
+	ImGui::Text("Frame %llu: %.3f ms, %llu events lost", static_cast<unsigned long long>(frame.m_index), frameTime,
+		static_cast<unsigned long long>(m_lostEvents));
+
+	/* Threads are drawn in index order, scopes are stacked by depth */
+	std::vector<uint32_t> threads;
+	for (const ProfileEvent& event : frame.m_events)
+	{
+		if (std::find(threads.begin(), threads.end(), event.m_thread) == threads.end())
+		{
+			threads.push_back(event.m_thread);
+		}
+	}
+	std::sort(threads.begin(), threads.end());
+
+	ImDrawList* drawList = ImGui::GetWindowDrawList();
+	float width = std::max(ImGui::GetContentRegionAvail().x, 1.0f);
+	double scale = width / static_cast<double>(frame.m_end - frame.m_start);
+
+	for (uint32_t thread : threads)
+	{
+		if (thread == 0U)
+		{
+			ImGui::TextUnformatted("Main");
+		}
+		else
+		{
+			ImGui::Text("Worker %u", thread);
+		}
+
+		ImVec2 origin = ImGui::GetCursorScreenPos();
+		uint32_t maxDepth = 0U;
+		for (const ProfileEvent& event : frame.m_events)
+		{
+			if (event.m_thread != thread)
+			{
+				continue;
+			}
+			maxDepth = std::max(maxDepth, event.m_depth);
+
+			uint64_t start = std::max(event.m_start, frame.m_start) - frame.m_start;
+			uint64_t end = std::min(event.m_end, frame.m_end) - frame.m_start;
+			ImVec2 min(origin.x + static_cast<float>(start * scale), origin.y + event.m_depth * FLAME_ROW_HEIGHT);
+			ImVec2 max(std::max(origin.x + static_cast<float>(end * scale), min.x + 1.0f), min.y + FLAME_ROW_HEIGHT - 1.0f);
+
+			drawList->AddRectFilled(min, max, ImColor::HSV(NameHue(event.m_name), 0.5f, 0.6f));
+			drawList->PushClipRect(min, max, true);
+			drawList->AddText(ImVec2(min.x + 2.0f, min.y + 1.0f), IM_COL32_WHITE, event.m_name);
+			drawList->PopClipRect();
+
+			if (ImGui::IsMouseHoveringRect(min, max))
+			{
+				ImGui::SetTooltip("%s: %.3f ms", event.m_name, (event.m_end - event.m_start) / 1000000.0);
+			}
+		}
+
+		ImGui::Dummy(ImVec2(width, (maxDepth + 1U) * FLAME_ROW_HEIGHT));
+	}
+
+	ImGui::End();
+}
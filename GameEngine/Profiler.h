@@ -0,0 +1,131 @@
+// Copyright (C) 2023  Mantas Naujokas
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "Macros.h"
+#include "Singleton.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/* Scope markers are compiled in unless the build defines PROFILER_ENABLED as 0 */
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 1
+#endif
+
+#if PROFILER_ENABLED
+// PROFILE_SCOPE: times the rest of the enclosing scope, name has to outlive the profiler
+#define PROFILE_SCOPE(name) ProfileScope CONCAT(profileScope, __LINE__)(name)
+#else
+#define PROFILE_SCOPE(name)
+#endif
+
+/* ProfileEvent - one timed scope, times are nanoseconds since the profiler was created */
+struct ProfileEvent
+{
+	const char* m_name;
+	uint64_t m_start;
+	uint64_t m_end;
+	uint32_t m_depth;	// number of enclosing scopes on the same thread
+	uint32_t m_thread;	// JobSystem thread index
+};
+
+/* ProfileScope - records a ProfileEvent when it goes out of scope, use through PROFILE_SCOPE */
+class ProfileScope
+{
+public:
+	explicit ProfileScope(const char* name);
+	~ProfileScope(void);
+	ProfileScope(const ProfileScope& rhs) = delete;
+
+private:
+	const char* m_name;
+	uint64_t m_start;
+};
+
+/* Profiler - collects scope events of every thread once per frame. Threads write to their own
+ring buffers without locking, EndFrame reads them on the main thread */
+class Profiler : public Singleton<Profiler>
+{
+public:
+	Profiler(void);
+	~Profiler(void);
+	Profiler(const Profiler& rhs) = delete;
+
+	void BeginFrame(void);
+	void EndFrame(void);	// collects events recorded since BeginFrame, threads must not be inside the frame's scopes
+
+	// StartTrace: frames firstFrame to lastFrame are written to a Chrome trace file at path, lastFrame 0 traces until StopTrace
+	void StartTrace(const std::string& path, uint64_t firstFrame, uint64_t lastFrame);
+	void StopTrace(void);	// writes frames traced so far
+	uint64_t GetFrameIndex(void) const;	// index of the frame being recorded
+
+	void ShowFlameGraph(void);
+
+	void Record(const ProfileEvent& event);
+	static uint64_t Now(void);	// nanoseconds since the profiler was created
+
+private:
+	static const size_t ThreadBufferSize = 8192U;	// events a thread can record between two EndFrame calls
+	static const size_t HistorySize = 120U;	// frames kept for the flame graph
+
+	struct ThreadBuffer
+	{
+		uint32_t m_thread = 0U;
+		std::atomic<uint64_t> m_written{ 0U };	// published by the owning thread
+		uint64_t m_read = 0U;	// main thread only
+		ProfileEvent m_events[ThreadBufferSize];
+	};
+
+	struct ProfileFrame
+	{
+		uint64_t m_index = 0U;
+		uint64_t m_start = 0U;
+		uint64_t m_end = 0U;
+		std::vector<ProfileEvent> m_events;
+	};
+
+	ThreadBuffer* RegisterThread(void);
+	void CollectEvents(std::vector<ProfileEvent>& events);
+	bool WriteTrace(void) const;
+
+private:
+	std::vector<ThreadBuffer*> m_threadBuffers;
+	std::mutex m_threadBuffersMutex;	// guards the list, not the buffers
+	uint64_t m_lostEvents;	// overwritten before EndFrame read them
+
+	std::vector<ProfileFrame> m_history;	// ring of the last HistorySize frames
+	uint64_t m_frameIndex;
+	uint64_t m_frameStart;
+	uint64_t m_lastStoredFrame;	// newest frame in the history
+	std::vector<ProfileEvent> m_frameEvents;
+
+	/* Flame graph view */
+	bool m_paused;
+	int m_viewedFrame;	// frames back from the last one
+	int m_captureFrames;
+
+	/* Chrome trace capture */
+	std::string m_tracePath;
+	uint64_t m_traceFirstFrame;
+	uint64_t m_traceLastFrame;
+	bool m_tracing;
+	std::vector<ProfileFrame> m_traceFrames;
+};
+
+#endif
@@ -0,0 +1,104 @@
+// Copyright (C) 2023  Mantas Naujokas
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "RenderList.h"
+#include "GameObject.h"
+#include "GameObjectFactory.h"
+#include "GraphicsComponent.h"
+#include "Profiler.h"
+#include "SceneComponent.h"
+#include <stdio.h>
+
+RenderList::RenderList(void)
+	: m_listVersion(UINT64_MAX)
+{}
+
+void RenderList::Build(const GameObjectFactory& GOF)
+{
+	PROFILE_SCOPE("RenderList::Build");
+	uint64_t listVersion = GOF.GetObjectListVersion();
+	if (listVersion != m_listVersion)
+	{
+		RebuildDormant(GOF);
+		m_listVersion = listVersion;
+	}
+
+	m_packages = m_dormantPackages;
+	for (const GameObject* obj : m_awakeObjects)
+	{
+		CollectPackages(obj, m_packages);
+	}
+}
+
+void RenderList::Clear(void)
+{
+	m_packages.clear();
+}
+
+const std::vector<RenderPackage>& RenderList::GetPackages(void) const
+{
+	return m_packages;
+}
+
+void RenderList::RebuildDormant(const GameObjectFactory& GOF)
+{
+	m_dormantPackages.clear();
+	m_awakeObjects.clear();
+
+	const std::vector<GameObject*>& objects = GOF.GetObjectList();
+	for (const GameObject* obj : objects)
+	{
+		if (obj->IsDormant())
+		{
+			if (CollectPackages(obj, m_dormantPackages))
+			{
+				continue;
+			}
+			/* resources are still loading, checked every frame until they are */
+		}
+		m_awakeObjects.push_back(obj);
+	}
+}
+
+bool RenderList::CollectPackages(const GameObject* obj, std::vector<RenderPackage>& packages)
+{
+	std::vector<GraphicsComponent*> graphics;
+	std::vector<SceneComponent*> scene;
+	obj->QueryComponents(graphics);
+	obj->QueryComponents(scene);
+
+	if (scene.empty())
+	{
+		fprintf(stderr, "RenderList::%s: %s does not contain SceneComponent\n",
+			__func__, obj->GetObjectTypeName().c_str());
+		return true;
+	}
+
+	bool allInitialized = true;
+	for (GraphicsComponent* graphicsComp : graphics)
+	{
+		if (graphicsComp->IsInitialized())
+		{
+			RenderPackage renderPackage = { graphicsComp, scene[0] };
+			packages.push_back(renderPackage);
+		}
+		else
+		{
+			allInitialized = false;
+		}
+	}
+
+	return allInitialized;
+}
@@ -0,0 +1,57 @@
+// Copyright (C) 2023  Mantas Naujokas
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef RENDERLIST_H
+#define RENDERLIST_H
+
+#include <stdint.h>
+#include <vector>
+
+class GameObject;
+class GameObjectFactory;
+class GraphicsComponent;
+class SceneComponent;
+
+struct RenderPackage
+{
+	GraphicsComponent* m_graphicsComponent = nullptr;
+	SceneComponent* m_sceneComponent = nullptr;
+};
+
+/* RenderList - render packages of the factory's objects, built the same way by every graphics backend.
+Packages of dormant objects are kept until the object list changes, awake objects are collected every frame */
+class RenderList
+{
+public:
+	RenderList(void);
+
+	void Build(const GameObjectFactory& GOF);
+	void Clear(void);	// drops this frame's packages, cached dormant packages are kept
+
+	const std::vector<RenderPackage>& GetPackages(void) const;
+
+private:
+	void RebuildDormant(const GameObjectFactory& GOF);
+	// CollectPackages: adds packages of object's initialized graphics components, false if any is still loading
+	static bool CollectPackages(const GameObject* obj, std::vector<RenderPackage>& packages);
+
+private:
+	std::vector<RenderPackage> m_packages;
+	std::vector<RenderPackage> m_dormantPackages;	// rebuilt only when the object list changes
+	std::vector<const GameObject*> m_awakeObjects;	// objects collected into m_packages every frame
+	uint64_t m_listVersion;	// object list version m_dormantPackages was built for
+};
+
+#endif
@@ -14,6 +14,7 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "SceneComponent.h"
+#include "BinaryStream.h"
 #include "GameObjectFactory.h"
 #include "JSONData.h"
 
@@ -39,6 +40,27 @@ void SceneComponent::Deserialize(const JSONData& source)
 	}
 }
 
+void SceneComponent::WriteBinary(BinaryWriter& writer) const
+{
+	writer.Write(m_transform.GetPosition());
+	writer.Write(m_transform.GetScale());
+	writer.Write(m_transform.GetRotation());
+}
+
+void SceneComponent::ReadBinary(BinaryReader& reader)
+{
+	Vector3 position = m_transform.GetPosition();
+	Vector3 scale = m_transform.GetScale();
+	Vector3 rotation = m_transform.GetRotation();
+	reader.Read(position);
+	reader.Read(scale);
+	reader.Read(rotation);
+
+	m_transform.SetPosition(position);
+	m_transform.SetScale(scale);
+	m_transform.SetRotation(rotation);
+}
+
 Component* SceneComponent::Clone(void) const
 {
 	Component* clone = new SceneComponent(*this);
@@ -58,6 +80,10 @@ const std::string& SceneComponent::GetClassTypeName(void)
 
 Transform& SceneComponent::GetTransform(void)
 {
+	if (IsDormant())
+	{ // moved objects have to be picked up by physics again
+		Wake();
+	}
 	return m_transform;
 }
 
@@ -66,7 +92,25 @@ const Transform& SceneComponent::GetTransform(void) const
 	return m_transform;
 }
 
-void SceneComponent::SetTransform(const Matrix& transform)
+void SceneComponent::SetTransform(const Matrix& transform, uint64_t tick)
 {
+	if (tick != m_transformTick)
+	{ // a new object has no earlier matrix to start from
+		m_previousTransform = m_transformTick != 0U ? m_transform.GetTransformMatrix() : transform;
+		m_transformTick = tick;
+	}
+
 	m_transform.SetTransformMatrix(transform);
 }
+
+Matrix SceneComponent::GetInterpolatedTransform(uint64_t lastTick, float alpha) const
+{
+	const Matrix& transform = m_transform.GetTransformMatrix();
+	if (m_transformTick != lastTick || alpha >= 1.0f)
+	{
+		return transform;
+	}
+
+	/* Element-wise: exact for translation and scale, close enough for the rotation of one tick */
+	return m_previousTransform + (transform - m_previousTransform) * alpha;
+}
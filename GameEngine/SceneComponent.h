@@ -31,22 +31,31 @@ public:
 	SceneComponent(const SceneComponent& rhs) = default;
 
 	void Deserialize(const JSONData& source) override;
+	void WriteBinary(BinaryWriter& writer) const override;
+	void ReadBinary(BinaryReader& reader) override;
 
 	Component* Clone(void) const override;
 
 	const std::string& GetObjectTypeName(void) const override;
 	static const std::string& GetClassTypeName(void);
 
-	// Returns references to object's transform data
+	// Returns references to object's transform data, mutable access wakes a dormant object
 	Transform& GetTransform(void);
 	const Transform& GetTransform(void) const;
 
-	// Set new transform data to the object
-	void SetTransform(const Matrix& transform);
+	// SetTransform: new transform matrix of a simulation tick, the first set in a tick keeps the matrix it replaces
+	void SetTransform(const Matrix& transform, uint64_t tick);
+	// GetInterpolatedTransform: matrix between the last two ticks, alpha 0 is the previous tick and 1 the last one.
+	// Objects that did not move in lastTick return their transform matrix
+	Matrix GetInterpolatedTransform(uint64_t lastTick, float alpha) const;
 
 private:
 	// Object's transform data
 	Transform m_transform;
+
+	// Transform matrix before the tick that last set it
+	Matrix m_previousTransform;
+	uint64_t m_transformTick = 0U;	// 0 until the first SetTransform
 };
 
 #endif
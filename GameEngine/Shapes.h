@@ -36,6 +36,8 @@ public:
 	Vector3 m_center;
 	Vector3 m_previousCenter; // for calculating movement
 
+	virtual ~Shape(void) {}
+
 protected:
 	Shape(ShapeType type, const std::string& typeStr, const Vector3& center)
 		: m_type(type)
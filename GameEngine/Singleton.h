@@ -16,7 +16,9 @@
 #ifndef SINGLETON_H
 #define SINGLETON_H
 
+#include "Platform.h"
 #include <typeinfo>
+#include <stdint.h>
 #include <stdio.h>
 
 template <typename Class>
@@ -28,7 +30,7 @@ public:
 		if (m_objStored == m_size)
 		{
 			fprintf(stderr, "%s: cannot create Singleton, storage limit reached\n", __func__);
-			__debugbreak();
+			DEBUG_BREAK();
 		}
 		size_t id = typeid(Class).hash_code();
 
@@ -37,7 +39,7 @@ public:
 			if (m_storage[i].idHash == id)
 			{
 				fprintf(stderr, "%s: cannot create a duplicate singleton\n", __func__);
-				__debugbreak();
+				DEBUG_BREAK();
 			}
 		}
 
@@ -19,6 +19,7 @@
 Subscriber::Subscriber(Messenger& messenger)
 	: m_messenger(messenger)
 	, m_bindingSlotIndex(UINT64_MAX)
+	, m_address(UINT64_MAX)
 {}
 
 Subscriber::~Subscriber(void)
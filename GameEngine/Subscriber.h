@@ -16,6 +16,9 @@
 #ifndef SUBSCRIBER_H
 #define SUBSCRIBER_H
 
+#include <cstddef>
+#include <cstdint>
+
 class Messenger;
 class Message;
 
@@ -38,6 +41,7 @@ protected:
 
 private:
 	size_t m_bindingSlotIndex;
+	uint64_t m_address;	// mailbox address, UINT64_MAX when not addressable
 };
 
 #endif
@@ -14,6 +14,8 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "Window.h"
+
+#if PLATFORM_WIN32
 #include <cstdio>
 
 Window::Window(void)
@@ -65,3 +67,4 @@ const HWND Window::GetHandle(void) const
 {
 	return m_handle;
 }
+#endif
@@ -16,6 +16,9 @@
 #ifndef WINDOW_H
 #define	WINDOW_H
 
+#include "Platform.h"
+
+#if PLATFORM_WIN32
 #include <Windows.h>
 
 class Window
@@ -35,3 +38,5 @@ private:
 };
 
 #endif
+
+#endif
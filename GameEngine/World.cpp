@@ -14,10 +14,16 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "World.h"
+#include "App.h"
 #include "GameObjectFactory.h"
 #include "Camera.h"
 #include "JSONData.h"
+#include "Profiler.h"
 #include "StringUtility.h"
+#include <algorithm>
+#include <typeinfo>
+
+static const size_t ParallelUpdateGrainSize = 256U;	// objects per job in the parallel update
 
 World::World(void)
 	: m_camera(nullptr)
@@ -44,7 +50,8 @@ bool World::Deserialize(JSONDoc* data)
 		return false;
 	}
 
-	/* Populate m_worldObjects */
+	/* Populate m_worldObjects, overrides allocate from the world's arena as well */
+	MemoryArena* previousArena = GOF->SetAllocationArena(&m_arena);
 	JSONDoc::ConstValueIterator iter = worldObjects.GetArrayBegin();
 	JSONDoc::ConstValueIterator arrayEnd = worldObjects.GetArrayEnd();
 	while (iter != arrayEnd)
@@ -63,6 +70,7 @@ bool World::Deserialize(JSONDoc* data)
 		}
 		++iter;
 	}
+	GOF->SetAllocationArena(previousArena);
 
 	return true;
 }
@@ -74,15 +82,71 @@ void World::Serialize(void)
 
 void World::Update(float deltaTime)
 {
-	for (GameObject* obj : m_worldObjects)
+	PROFILE_SCOPE("World::Update");
+	ApplyDormancyChanges();
+
+	/* Buckets update in creation order whether they run in parallel or not, like a serial update */
+	for (UpdateBucket& bucket : m_updateBuckets)
+	{
+		if (bucket.m_update == nullptr || bucket.m_objects.empty())
+		{
+			continue;
+		}
+
+		if (bucket.m_parallel)
+		{
+			UpdateParallel(bucket, deltaTime);
+		}
+		else
+		{
+			bucket.m_update(bucket.m_objects.data(), bucket.m_objects.size(), deltaTime);
+		}
+	}
+}
+
+void World::UpdateParallel(const UpdateBucket& bucket, float deltaTime)
+{
+	App* app = App::Get();
+	Messenger& messenger = app->GetMessenger();
+	EntityCommandBuffer& commandBuffer = GameObjectFactory::Get()->GetCommandBuffer();
+
+	size_t numObjects = bucket.m_objects.size();
+	m_updateChunks.resize((numObjects + ParallelUpdateGrainSize - 1U) / ParallelUpdateGrainSize);
+
+	app->GetJobSystem().ParallelFor(numObjects, ParallelUpdateGrainSize, [this, &bucket, deltaTime](size_t begin, size_t end)
+		{
+			UpdateChunk& chunk = m_updateChunks[begin / ParallelUpdateGrainSize];
+			Messenger::Outbox* previousOutbox = Messenger::BindOutbox(&chunk.m_outbox);
+			EntityCommandBuffer::ThreadBuffer* previousBuffer = EntityCommandBuffer::BindThreadBuffer(&chunk.m_commands);
+
+			bucket.m_update(bucket.m_objects.data() + begin, end - begin, deltaTime);
+
+			Messenger::BindOutbox(previousOutbox);	// the first range runs on the calling thread, inside the system's binding
+			EntityCommandBuffer::BindThreadBuffer(previousBuffer);
+		});
+
+	/* Chunk order matches object order, output is the same as a serial update of the bucket */
+	for (UpdateChunk& chunk : m_updateChunks)
 	{
-		obj->Update(deltaTime);
+		messenger.MergeOutbox(chunk.m_outbox);
+		commandBuffer.MergeThreadBuffer(chunk.m_commands);
 	}
 }
 
 void World::AddObject(GameObject* object)
 {
 	m_worldObjects.push_back(object);
+
+	UpdateBucket& bucket = FindBucket(object);
+	if (!object->IsDormant())
+	{
+		bucket.m_objects.push_back(object);
+	}
+}
+
+void World::ReserveObjects(size_t count)
+{
+	m_worldObjects.reserve(m_worldObjects.size() + count);
 }
 
 void World::RemoveObject(GameObject* object)
@@ -97,17 +161,55 @@ void World::RemoveObject(GameObject* object)
 		}
 		++iter;
 	}
+
+	std::vector<GameObject*>& bucketObjects = FindBucket(object).m_objects;
+	std::vector<GameObject*>::iterator bucketIter = std::find(bucketObjects.begin(), bucketObjects.end(), object);
+	if (bucketIter != bucketObjects.end())
+	{
+		bucketObjects.erase(bucketIter);
+	}
+
+	std::lock_guard<std::mutex> lock(m_dormancyMutex);
+	m_dormancyChanges.erase(std::remove(m_dormancyChanges.begin(), m_dormancyChanges.end(), object), m_dormancyChanges.end());
 }
 
-void World::Destroy(void)
+void World::RemoveObjects(const std::vector<GameObject*>& sortedObjects)
 {
-	GameObjectFactory* GOF = GameObjectFactory::Get();
+	std::function<bool(GameObject*)> isRemoved = [&sortedObjects](GameObject* object)
+		{
+			return std::binary_search(sortedObjects.begin(), sortedObjects.end(), object);
+		};
 
-	while (!m_worldObjects.empty())
+	m_worldObjects.erase(std::remove_if(m_worldObjects.begin(), m_worldObjects.end(), isRemoved), m_worldObjects.end());
+	for (UpdateBucket& bucket : m_updateBuckets)
 	{
-		GOF->DeleteObject(*m_worldObjects.begin());
+		bucket.m_objects.erase(std::remove_if(bucket.m_objects.begin(), bucket.m_objects.end(), isRemoved), bucket.m_objects.end());
 	}
 
+	std::lock_guard<std::mutex> lock(m_dormancyMutex);
+	m_dormancyChanges.erase(std::remove_if(m_dormancyChanges.begin(), m_dormancyChanges.end(), isRemoved), m_dormancyChanges.end());
+}
+
+void World::QueueDormancyChange(GameObject* object)
+{
+	std::lock_guard<std::mutex> lock(m_dormancyMutex);
+	m_dormancyChanges.push_back(object);
+}
+
+void World::Destroy(void)
+{
+	GameObjectFactory* GOF = GameObjectFactory::Get();
+
+	/* Destructors still run, storage is reclaimed by releasing the whole arena */
+	m_arena.BeginRelease();
+	GOF->DeleteWorldObjects(this, m_worldObjects);
+	m_worldObjects.clear();
+	m_updateBuckets.clear();
+	m_bucketIndices[0].clear();
+	m_bucketIndices[1].clear();
+	m_dormancyChanges.clear();
+	m_arena.Release();
+
 	m_camera = nullptr;
 }
 
@@ -116,6 +218,58 @@ Camera* World::GetCamera(void) const
 	return m_camera;
 }
 
+MemoryArena& World::GetArena(void)
+{
+	return m_arena;
+}
+
+World::UpdateBucket& World::FindBucket(const GameObject* object)
+{
+	/* Every object class has its own type name, the class hash finds the bucket without comparing names */
+	bool parallel = object->IsParallelUpdate();
+	std::pair<std::unordered_map<size_t, size_t>::iterator, bool> inserted =
+		m_bucketIndices[parallel ? 1 : 0].emplace(typeid(*object).hash_code(), m_updateBuckets.size());
+	if (inserted.second)
+	{
+		const std::string& type = object->GetObjectTypeName();
+		UpdateBucket newBucket = { type, GameObjectFactory::Get()->GetBatchUpdate(type), parallel, {} };
+		m_updateBuckets.push_back(newBucket);
+	}
+	return m_updateBuckets[inserted.first->second];
+}
+
+void World::ApplyDormancyChanges(void)
+{
+	std::vector<GameObject*> changes;
+	{
+		std::lock_guard<std::mutex> lock(m_dormancyMutex);
+		changes.swap(m_dormancyChanges);
+	}
+
+	if (changes.empty())
+	{
+		return;
+	}
+
+	/* Take changed objects out of their buckets in one pass, then add back the ones that are awake */
+	std::sort(changes.begin(), changes.end());
+	changes.erase(std::unique(changes.begin(), changes.end()), changes.end());
+
+	for (UpdateBucket& bucket : m_updateBuckets)
+	{
+		bucket.m_objects.erase(std::remove_if(bucket.m_objects.begin(), bucket.m_objects.end(),
+			[&changes](GameObject* object) { return std::binary_search(changes.begin(), changes.end(), object); }), bucket.m_objects.end());
+	}
+
+	for (GameObject* object : changes)
+	{
+		if (!object->IsDormant())
+		{
+			FindBucket(object).m_objects.push_back(object);
+		}
+	}
+}
+
 void World::OverrideObjectData(GameObject* object, JSONData data) const
 {
 	object->Deserialize(data);
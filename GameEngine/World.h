@@ -16,9 +16,15 @@
 #ifndef WORLD_H
 #define WORLD_H
 
+#include <mutex>
 #include <vector>
 #include <string>
+#include <unordered_map>
+#include "EntityCommandBuffer.h"
+#include "GameObject.h"
 #include "JSONDefinitions.h"
+#include "MemoryArena.h"
+#include "Messenger.h"
 
 class GameObject;
 class JSONData;
@@ -38,15 +44,39 @@ public:
 	void Update(float deltaTime);
 
 	void AddObject(GameObject* object);
+	void ReserveObjects(size_t count);	// makes room for count more objects
 	void RemoveObject(GameObject* object);
+	void RemoveObjects(const std::vector<GameObject*>& sortedObjects);	// sortedObjects has to be sorted
+	// QueueDormancyChange: object is moved in or out of update buckets at the start of next Update
+	void QueueDormancyChange(GameObject* object);
 
 	void Destroy(void);
 	// void SaveAndDestroy(void);
 
 	Camera* GetCamera(void) const;
+	MemoryArena& GetArena(void);
 
 private:
+	/* UpdateBucket - world objects of one concrete type, updated in one loop without virtual calls */
+	struct UpdateBucket
+	{
+		std::string m_type;
+		GameObject::BatchUpdateFunction m_update;	// nullptr for types that do not update
+		bool m_parallel;	// objects are flagged for parallel update
+		std::vector<GameObject*> m_objects;
+	};
+
+	/* UpdateChunk - sends and commands made while updating a range of parallel objects */
+	struct UpdateChunk
+	{
+		Messenger::Outbox m_outbox;
+		EntityCommandBuffer::ThreadBuffer m_commands;
+	};
+
 	void OverrideObjectData(GameObject* object, JSONData data) const;
+	UpdateBucket& FindBucket(const GameObject* object);
+	void ApplyDormancyChanges(void);
+	void UpdateParallel(const UpdateBucket& bucket, float deltaTime);	// updates bucket's objects on the job system
 
 protected:
 	/* World objects: game objects belonging to a particular world */
@@ -54,6 +84,13 @@ protected:
 
 private:
 	Camera* m_camera;
+	std::vector<UpdateBucket> m_updateBuckets;	// in order of first added object of each type
+	std::unordered_map<size_t, size_t> m_bucketIndices[2];	// by object class hash, serial then parallel buckets
+	std::vector<UpdateChunk> m_updateChunks;
+	std::vector<GameObject*> m_dormancyChanges;	// objects woken or put to sleep since last Update
+	std::mutex m_dormancyMutex;
+	/* Storage of world's objects, components and colliders */
+	MemoryArena m_arena;
 };
 
 #endif
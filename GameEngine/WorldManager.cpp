@@ -17,7 +17,9 @@
 #include "Messenger.h"
 #include "MessagesWorldManager.h"
 #include "MessageFileRequest.h"
+#include "Profiler.h"
 #include "StringUtility.h"
+#include <imgui.h>
 
 WorldManager::WorldManager(Messenger& messenger)
 	: Subscriber(messenger)
@@ -54,6 +56,7 @@ void WorldManager::UpdateWorlds(float deltaTime)
 
 bool WorldManager::LoadWorld(WorldType toWorld, const std::string& filename)
 {
+	PROFILE_SCOPE("WorldManager::LoadWorld");
 	World* world = nullptr;
 	switch (toWorld)
 	{
@@ -93,6 +96,43 @@ World* WorldManager::GetActiveWorld(void)
 	return &m_activeWorld;
 }
 
+void WorldManager::ShowArenaStatistics(void)
+{
+	ImGui::Begin("World Arenas");
+
+	if (ImGui::BeginTable("Arenas", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+	{
+		ImGui::TableSetupColumn("World");
+		ImGui::TableSetupColumn("Used KB");
+		ImGui::TableSetupColumn("Peak KB");
+		ImGui::TableSetupColumn("Capacity KB");
+		ImGui::TableSetupColumn("Chunks");
+		ImGui::TableHeadersRow();
+
+		std::pair<const char*, World*> worlds[] = { { "Persistent", &m_persistentWorld }, { "Active", &m_activeWorld } };
+		for (std::pair<const char*, World*> it : worlds)
+		{
+			const MemoryArena& arena = it.second->GetArena();
+
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(it.first);
+			ImGui::TableNextColumn();
+			ImGui::Text("%zu", arena.GetUsedBytes() / 1024U);
+			ImGui::TableNextColumn();
+			ImGui::Text("%zu", arena.GetPeakUsedBytes() / 1024U);
+			ImGui::TableNextColumn();
+			ImGui::Text("%zu", arena.GetCapacity() / 1024U);
+			ImGui::TableNextColumn();
+			ImGui::Text("%zu", arena.GetNumChunks());
+		}
+
+		ImGui::EndTable();
+	}
+
+	ImGui::End();
+}
+
 void WorldManager::ReadWorldData(const std::string& filePath)
 {
 	std::string filename = StringUtility::ExtractFilenameFromPath(filePath);
@@ -45,6 +45,9 @@ public:
 
 	World* GetActiveWorld(void);
 
+	// Draws world arena usage in an ImGui window
+	void ShowArenaStatistics(void);
+
 private:
 	void ReadWorldData(const std::string& file);
 
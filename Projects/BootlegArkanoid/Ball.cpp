@@ -14,6 +14,7 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "Ball.h"
+#include "BinaryStream.h"
 #include "GameObjectFactory.h"
 #include "JSONData.h"
 #include "PhysicsComponent.h"
@@ -25,11 +26,15 @@ void Ball::Register(void)
 
 Ball::Ball(void)
 	: GameObject(0U, nullptr)
-{}
+{
+	SetParallelUpdate(true);
+}
 
 Ball::Ball(uint64_t id, World* parentWorld)
 	: GameObject(id, parentWorld)
-{}
+{
+	SetParallelUpdate(true);	// only touches its own components
+}
 
 void Ball::Initialize(void)
 {
@@ -42,6 +47,18 @@ void Ball::Deserialize(const JSONData& source)
 	source.GetVector3("direction", m_direction);
 }
 
+void Ball::WriteBinary(BinaryWriter& writer) const
+{
+	writer.Write(m_velocity);
+	writer.Write(m_direction);
+}
+
+void Ball::ReadBinary(BinaryReader& reader)
+{
+	reader.Read(m_velocity);
+	reader.Read(m_direction);
+}
+
 GameObject* Ball::Clone(World* parentWorld) const
 {
 	GameObject* clone = new Ball(GameObjectFactory::Get()->GenerateID(), parentWorld);
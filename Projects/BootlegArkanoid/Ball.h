@@ -35,6 +35,8 @@ private:
 
 	void Initialize(void) override;
 	void Deserialize(const JSONData& source);
+	void WriteBinary(BinaryWriter& writer) const override;
+	void ReadBinary(BinaryReader& reader) override;
 
 	GameObject* Clone(World* parentWorld) const override;
 
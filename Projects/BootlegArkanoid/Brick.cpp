@@ -14,6 +14,7 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "Brick.h"
+#include "BinaryStream.h"
 #include "GameObjectFactory.h"
 #include "JSONData.h"
 #include "ColorDefinitions.h"
@@ -38,7 +39,9 @@ Brick::Brick(uint64_t id, World* parentWorld)
 	: GameObject(id, parentWorld)
 	, m_startingLives(1)
 	, m_remainingLives(1)
-{}
+{
+	SetDormant(true);	// never moves, hits are handled in CollisionReact
+}
 
 void Brick::Deserialize(const JSONData& source)
 {
@@ -50,6 +53,20 @@ void Brick::Deserialize(const JSONData& source)
 	}
 }
 
+void Brick::WriteBinary(BinaryWriter& writer) const
+{
+	writer.Write(m_startingLives);
+}
+
+void Brick::ReadBinary(BinaryReader& reader)
+{
+	int lives = -1;
+	if (reader.Read(lives))
+	{
+		m_startingLives = m_remainingLives = lives;
+	}
+}
+
 GameObject* Brick::Clone(World* parentWorld) const
 {
 	GameObject* clone = new Brick(GameObjectFactory::Get()->GenerateID(), parentWorld);
@@ -100,7 +117,7 @@ void Brick::ChangeColor(void)
 		gc[0]->m_material->m_color = Color(COLOR_BRICK_1);
 		break;
 	default:
-		gc[0]->m_material->m_color = Color({ 1.0f, 1.0f, 1.0f });
+		gc[0]->m_material->m_color = Color(1.0f, 1.0f, 1.0f);
 		break;
 	}
 }
@@ -17,14 +17,14 @@
 #define COLORDEFINITIONS_H
 
 // Bricks
-#define COLOR_BRICK_1 { 0.52f, 0.87f, 0.01f } // lawn green
-#define COLOR_BRICK_2 { 1.0f, 0.75f, 0.0f } // light amber
-#define COLOR_BRICK_3 { 0.89f, 0.15f, 0.21f } // crimson red
+#define COLOR_BRICK_1 0.52f, 0.87f, 0.01f // lawn green
+#define COLOR_BRICK_2 1.0f, 0.75f, 0.0f // light amber
+#define COLOR_BRICK_3 0.89f, 0.15f, 0.21f // crimson red
 
 // Wall
-#define COLOR_WALL { 1.0f, 0.49f, 0.0f } // amber
+#define COLOR_WALL 1.0f, 0.49f, 0.0f // amber
 
 // Paddle
-#define COLOR_PADDLE { 0.0f, 0.28f, 0.73f} // navy blue
+#define COLOR_PADDLE 0.0f, 0.28f, 0.73f // navy blue
 
 #endif
\ No newline at end of file
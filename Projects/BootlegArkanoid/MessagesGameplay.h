@@ -17,12 +17,26 @@
 #define MESSAGESGAMEPLAY_H
 
 #include "Message.h"
+#include "BinaryStream.h"
 
 class BrickHitMessage : public Message
 {
 public:
 	MESSAGE_CTOR(BrickHitMessage) {}
 
+	/* Journal serialization */
+	void WriteBinary(BinaryWriter& writer) const
+	{
+		writer.Write(m_scoreMultiplier);
+	}
+
+	static BrickHitMessage ReadBinary(BinaryReader& reader)
+	{
+		BrickHitMessage message;
+		reader.Read(message.m_scoreMultiplier);
+		return message;
+	}
+
 public:
 	int m_scoreMultiplier = 1;
 };
@@ -31,6 +45,15 @@ class LoseConditionMetMessage : public Message
 {
 public:
 	MESSAGE_CTOR(LoseConditionMetMessage) {}
+
+	/* Journal serialization, the message has no fields */
+	void WriteBinary(BinaryWriter&) const
+	{}
+
+	static LoseConditionMetMessage ReadBinary(BinaryReader&)
+	{
+		return LoseConditionMetMessage();
+	}
 };
 
 
@@ -130,6 +130,10 @@ bool MyGameplaySystem::Initialize(INIReader* ini)
 		GOF->RegisterObject<Brick>();
 		GOF->RegisterObject<Ball>();
 
+		MessageJournal& journal = m_appPtr->GetMessageJournal();
+		journal.RegisterType<BrickHitMessage>("BrickHitMessage");
+		journal.RegisterType<LoseConditionMetMessage>("LoseConditionMetMessage");
+
 		FileRequestMessage frm;
 		frm.m_extension = ".lvl";
 		frm.m_FileLoader = std::bind(&MyGameplaySystem::StoreMapFilename, this, std::placeholders::_1);
@@ -147,7 +151,12 @@ bool MyGameplaySystem::Initialize(INIReader* ini)
 	return GameplaySystem::Initialize(ini);
 }
 
-void MyGameplaySystem::Update(float deltaTime)
+const char* MyGameplaySystem::GetName(void) const
+{
+	return "MyGameplaySystem";
+}
+
+void MyGameplaySystem::UpdateUI(float deltaTime)
 {
 	if (m_UIState != UIState::NONE)
 	{
@@ -371,6 +380,43 @@ void MyGameplaySystem::Update(float deltaTime)
 		ImGui::End();
 	}
 
+	if (UIParams::showIngameScreen)
+	{
+		ImGui::Begin(UIParams::Text::InGame::title.c_str(), nullptr, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove);
+		if (UIParams::ingameInitialized)
+		{
+			if (m_livesRemaining != UIParams::lastLives)
+			{
+				UIParams::Text::InGame::fullLives = UIParams::Text::InGame::lives + std::to_string(m_livesRemaining);
+				UIParams::lastLives = m_livesRemaining;
+			}
+			if (m_currentScore != UIParams::lastScore)
+			{
+				UIParams::Text::InGame::fullScore = UIParams::Text::InGame::score + std::to_string(m_currentScore);
+				UIParams::lastScore = m_currentScore;
+			}
+			if (m_highScore != UIParams::lastHighScore)
+			{
+				UIParams::Text::InGame::fullHighScore = UIParams::Text::InGame::highScore + std::to_string(m_highScore);
+				UIParams::lastHighScore = m_highScore;
+			}
+			
+			ImGui::Text(UIParams::Text::InGame::fullLives.c_str());
+			ImGui::Text(UIParams::Text::InGame::fullScore.c_str());
+			ImGui::Text(UIParams::Text::InGame::fullHighScore.c_str());
+		}
+		else
+		{
+			ImGui::SetWindowPos({ 0.0f, 0.0f });
+			ImGui::SetWindowSize({ 200.0f, 100.0f });
+			UIParams::ingameInitialized = true;
+		}
+		ImGui::End();
+	}
+}
+
+void MyGameplaySystem::Update(float deltaTime)
+{
 	if (m_gameState == GameState::LoadWorld && m_worldManager->IsWorldDataAvailable())
 	{
 		m_worldManager->LoadWorld(WorldType::W_ACTIVE, m_maps[m_currentMapIndex]);
@@ -381,8 +427,8 @@ void MyGameplaySystem::Update(float deltaTime)
 
 	const std::vector<GameObject*> objects = m_GOF->GetObjectList();
 
-	if (m_gameState == GameState::InitializeAssets)
-	{
+	if (m_gameState == GameState::InitializeAssets && AreGraphicsInitialized(objects))
+	{ // material and model replies arrive a frame after the world is loaded
 		m_bricksRemaining = InitializeColors(objects);
 		m_gameState = GetNextGameState(m_gameState);
 		m_appPtr->m_appStateIsRunning = true;
@@ -399,18 +445,12 @@ void MyGameplaySystem::Update(float deltaTime)
 				Brick* br = static_cast<Brick*>(obj);
 				if (br->m_remainingLives == 0)
 				{
-					m_deletable.push_back(obj);
+					m_GOF->GetCommandBuffer().DestroyObject(obj);
 					--m_bricksRemaining;
 				}
 			}
 		}
 
-		for (GameObject* obj : m_deletable)
-		{
-			m_GOF->DeleteObject(obj);
-		}
-		m_deletable.clear();
-
 		if (m_bricksRemaining == 0)
 		{
 			m_appPtr->m_appStateIsRunning = false;
@@ -425,40 +465,6 @@ void MyGameplaySystem::Update(float deltaTime)
 		}
 	}
 
-	if (UIParams::showIngameScreen)
-	{
-		ImGui::Begin(UIParams::Text::InGame::title.c_str(), nullptr, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove);
-		if (UIParams::ingameInitialized)
-		{
-			if (m_livesRemaining != UIParams::lastLives)
-			{
-				UIParams::Text::InGame::fullLives = UIParams::Text::InGame::lives + std::to_string(m_livesRemaining);
-				UIParams::lastLives = m_livesRemaining;
-			}
-			if (m_currentScore != UIParams::lastScore)
-			{
-				UIParams::Text::InGame::fullScore = UIParams::Text::InGame::score + std::to_string(m_currentScore);
-				UIParams::lastScore = m_currentScore;
-			}
-			if (m_highScore != UIParams::lastHighScore)
-			{
-				UIParams::Text::InGame::fullHighScore = UIParams::Text::InGame::highScore + std::to_string(m_highScore);
-				UIParams::lastHighScore = m_highScore;
-			}
-			
-			ImGui::Text(UIParams::Text::InGame::fullLives.c_str());
-			ImGui::Text(UIParams::Text::InGame::fullScore.c_str());
-			ImGui::Text(UIParams::Text::InGame::fullHighScore.c_str());
-		}
-		else
-		{
-			ImGui::SetWindowPos({ 0.0f, 0.0f });
-			ImGui::SetWindowSize({ 200.0f, 100.0f });
-			UIParams::ingameInitialized = true;
-		}
-		ImGui::End();
-	}
-
 	GameplaySystem::Update(deltaTime);
 }
 
@@ -469,56 +475,56 @@ void MyGameplaySystem::Exit(void)
 
 void MyGameplaySystem::RegisterMessages(void)
 {
-	m_messenger.RegisterMessage<InputMessage>(this);
-	m_messenger.RegisterMessage<BrickHitMessage>(this);
-	m_messenger.RegisterMessage<LoseConditionMetMessage>(this);
+	m_messenger.Subscribe<InputMessage>(this, &MyGameplaySystem::OnInput);
+	m_messenger.SubscribeBatch<BrickHitMessage>(this, &MyGameplaySystem::OnBrickHits);
+	m_messenger.Subscribe<LoseConditionMetMessage>(this, &MyGameplaySystem::OnLoseConditionMet);
 }
 
-void MyGameplaySystem::ProcessMessage(const Message* message)
+void MyGameplaySystem::OnInput(const InputMessage& msg)
 {
-	if (message->IsType<InputMessage>())
+	if (msg.IsKeyTriggered(VIRTUAL_KEYS::K_ESC))
 	{
-		const InputMessage* msg = static_cast<const InputMessage*>(message);
-		if (msg->IsKeyTriggered(VIRTUAL_KEYS::K_ESC))
+		switch (m_UIState)
 		{
-			switch (m_UIState)
-			{
-			case UIState::ShowMain:
-			case UIState::ShowInterrupt:
-			case UIState::ShowGameOver:
-				m_appPtr->NotifyExit();
-				break;
-			case UIState::ShowPause:
-				m_UIState = UIState::NONE;
-				break;
-			case UIState::NONE:
-				m_UIState = UIState::ShowPause;
-				break;
-			default:
-				break;
-			}
-
-			m_appPtr->m_appStateIsRunning = !m_appPtr->m_appStateIsRunning; // pause/resume
+		case UIState::ShowMain:
+		case UIState::ShowInterrupt:
+		case UIState::ShowGameOver:
+			m_appPtr->NotifyExit();
+			break;
+		case UIState::ShowPause:
+			m_UIState = UIState::NONE;
+			break;
+		case UIState::NONE:
+			m_UIState = UIState::ShowPause;
+			break;
+		default:
+			break;
 		}
+
+		m_appPtr->m_appStateIsRunning = !m_appPtr->m_appStateIsRunning; // pause/resume
+	}
+}
+
+void MyGameplaySystem::OnBrickHits(const MessageSpan<BrickHitMessage>& hits)
+{
+	for (size_t i = 0U; i < hits.GetSize(); ++i)
+	{
+		m_currentScore += GameParams::DEF_BRICK_HIT_SCORE * hits[i].m_scoreMultiplier;
 	}
-	else if (message->IsType<BrickHitMessage>())
+	if (m_currentScore > m_highScore) { m_highScore = m_currentScore; }
+}
+
+void MyGameplaySystem::OnLoseConditionMet(const LoseConditionMetMessage& msg)
+{
+	m_appPtr->m_appStateIsRunning = false;
+	--m_livesRemaining;
+	if (m_livesRemaining == 0)
 	{
-		const BrickHitMessage* msg = static_cast<const BrickHitMessage*>(message);
-		m_currentScore += GameParams::DEF_BRICK_HIT_SCORE * msg->m_scoreMultiplier;
-		if (m_currentScore > m_highScore) { m_highScore = m_currentScore; }
+		m_UIState = UIState::ShowGameOver;
 	}
-	else if (message->IsType<LoseConditionMetMessage>())
+	else
 	{
-		m_appPtr->m_appStateIsRunning = false;
-		--m_livesRemaining;
-		if (m_livesRemaining == 0)
-		{
-			m_UIState = UIState::ShowGameOver;
-		}
-		else
-		{
-			m_UIState = UIState::ShowInterrupt;
-		}
+		m_UIState = UIState::ShowInterrupt;
 	}
 }
 
@@ -18,6 +18,12 @@
 
 #include "GameplaySystem.h"
 
+class InputMessage;
+class BrickHitMessage;
+class LoseConditionMetMessage;
+template <typename MessageType>
+class MessageSpan;
+
 class MyGameplaySystem : public GameplaySystem
 {
 public:
@@ -26,16 +32,21 @@ public:
 
 	bool Initialize(INIReader* ini) override final;
 	void Update(float deltaTime) override final;
+	void UpdateUI(float deltaTime) override final;	// menus and score, timers of the menus run at the frame rate
 	void Exit(void) override final;
+	const char* GetName(void) const override final;
 
 	void RegisterMessages(void) override final;
-	void ProcessMessage(const Message* message) override final;
 
 	void RegisterComponents(void) const override final;
 
 private:
 	enum class GameState;
 
+	void OnInput(const InputMessage& msg);
+	void OnBrickHits(const MessageSpan<BrickHitMessage>& hits);	// all hits of a frame in one call
+	void OnLoseConditionMet(const LoseConditionMetMessage& msg);
+
 	int InitializeColors(const std::vector<GameObject*>& objects) const; // sets correct colors to all objects returns number of bricks (required for win condition)
 	GameState GetNextGameState(const GameState& gs);
 
@@ -45,8 +56,6 @@ private:
 	std::vector<std::string> m_maps;
 	int m_currentMapIndex;
 
-	std::vector<GameObject*> m_deletable;	// storage for deletable objects
-
 	int m_currentScore;
 	int m_highScore;
 
@@ -14,6 +14,7 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "Paddle.h"
+#include "BinaryStream.h"
 #include "GameObjectFactory.h"
 #include "PhysicsComponent.h"
 #include "SceneComponent.h"
@@ -33,12 +34,14 @@ void Paddle::Register(void)
 
 Paddle::Paddle(void)
 	: GameObject(0U, nullptr)
+	, m_heldAction(GameActions::None)
 	, m_lastAction(GameActions::None)
 	, m_actionBlocked(GameActions::None)
 {}
 
 Paddle::Paddle(uint64_t id, World* parentWorld)
 	: GameObject(id, parentWorld)
+	, m_heldAction(GameActions::None)
 	, m_lastAction(GameActions::None)
 	, m_actionBlocked(GameActions::None)
 {}
@@ -67,6 +70,16 @@ void Paddle::Deserialize(const JSONData& source)
 	source.GetVector3("velocity", m_defaultVelocity);
 }
 
+void Paddle::WriteBinary(BinaryWriter& writer) const
+{
+	writer.Write(m_defaultVelocity);
+}
+
+void Paddle::ReadBinary(BinaryReader& reader)
+{
+	reader.Read(m_defaultVelocity);
+}
+
 GameObject* Paddle::Clone(World* parentWorld) const
 {
 	GameObject* clone = new Paddle(GameObjectFactory::Get()->GenerateID(), parentWorld);
@@ -77,67 +90,54 @@ void Paddle::Update(float deltaTime)
 {
 	std::vector<PhysicsComponent*> physComp;
 	QueryComponents(physComp);
-	physComp[0]->ResetVelocity();
 
-	size_t numActions = m_actionQueue.size();
-	if (numActions > 0U)
+	/* Held action applies on every simulation tick until the next InputMessage changes it, a frame may run several ticks */
+	Vector3 move = {};
+	if (m_heldAction != m_actionBlocked)
 	{
-		Vector3 move = {};
-		for (size_t i = 0; i < m_actionQueue.size(); ++i)
+		switch (m_heldAction)
 		{
-			GameActions action = m_actionQueue[i];
-			float axisVelocity = 0.0f;
-			if (action != m_actionBlocked)
-			{
-				switch (action)
-				{
-				case GameActions::MoveLeft:
-					axisVelocity = deltaTime * -m_defaultVelocity.x;
-					if (move.x != axisVelocity) { move.x += axisVelocity; }
-					break;
-				case GameActions::MoveRight:
-					axisVelocity = deltaTime * m_defaultVelocity.x;
-					if (move.x != axisVelocity) { move.x += axisVelocity; }
-					break;
+		case GameActions::MoveLeft:
+			move.x = deltaTime * -m_defaultVelocity.x;
+			break;
+		case GameActions::MoveRight:
+			move.x = deltaTime * m_defaultVelocity.x;
+			break;
 #ifdef _DEBUG
-				case GameActions::MoveUp:
-					axisVelocity = deltaTime * m_defaultVelocity.y;
-					if (move.y != axisVelocity) { move.y += axisVelocity; }
-					break;
-				case GameActions::MoveDown:
-					axisVelocity = deltaTime * -m_defaultVelocity.y;
-					if (move.y != axisVelocity) { move.y += axisVelocity; }
-					break;
+		case GameActions::MoveUp:
+			move.y = deltaTime * m_defaultVelocity.y;
+			break;
+		case GameActions::MoveDown:
+			move.y = deltaTime * -m_defaultVelocity.y;
+			break;
 #endif
-				default:
-					break;
-				}
-			}
+		default:
+			break;
 		}
-
-		physComp[0]->SetVelocity(move);
-		m_actionQueue.clear();
 	}
+
+	physComp[0]->SetVelocity(move);
 }
 
 void Paddle::ProcessInput(const InputMessage* msg)
 {
+	m_heldAction = GameActions::None;
 	if (msg->IsKeyTriggered(VIRTUAL_KEYS::K_LEFT) || msg->IsKeyPressed(VIRTUAL_KEYS::K_LEFT))
 	{
-		m_actionQueue.push_back(GameActions::MoveLeft);
+		m_heldAction = GameActions::MoveLeft;
 	}
 	else if (msg->IsKeyTriggered(VIRTUAL_KEYS::K_RIGHT) || msg->IsKeyPressed(VIRTUAL_KEYS::K_RIGHT))
 	{
-		m_actionQueue.push_back(GameActions::MoveRight);
+		m_heldAction = GameActions::MoveRight;
 	}
 #ifdef _DEBUG
 	else if (msg->IsKeyTriggered(VIRTUAL_KEYS::K_UP) || msg->IsKeyPressed(VIRTUAL_KEYS::K_UP))
 	{
-		m_actionQueue.push_back(GameActions::MoveUp);
+		m_heldAction = GameActions::MoveUp;
 	}
 	else if (msg->IsKeyTriggered(VIRTUAL_KEYS::K_DOWN) || msg->IsKeyPressed(VIRTUAL_KEYS::K_DOWN))
 	{
-		m_actionQueue.push_back(GameActions::MoveDown);
+		m_heldAction = GameActions::MoveDown;
 	}
 #endif
 }
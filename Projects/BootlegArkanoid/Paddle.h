@@ -48,6 +48,8 @@ private:
 
 	void Initialize(void) override;
 	void Deserialize(const JSONData& source);
+	void WriteBinary(BinaryWriter& writer) const override;
+	void ReadBinary(BinaryReader& reader) override;
 
 	GameObject* Clone(World* parentWorld) const override;
 
@@ -58,7 +60,7 @@ private:
 	static const std::string& GetClassTypeName(void);
 
 private:
-	std::vector<GameActions> m_actionQueue; // queue of actions to be performed by object this frame
+	GameActions m_heldAction; // action of the last InputMessage, performed on every simulation tick until the next one
 	GameActions m_lastAction; // last performed action
 	GameActions m_actionBlocked;
 
@@ -14,6 +14,7 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "Wall.h"
+#include "BinaryStream.h"
 #include "GameObjectFactory.h"
 #include "GraphicsComponent.h"
 #include "Material.h"
@@ -35,7 +36,9 @@ Wall::Wall(void)
 Wall::Wall(uint64_t id, World* parentWorld)
 	: GameObject(id, parentWorld)
 	, m_isLosingWall(false)
-{}
+{
+	SetDormant(true);	// never moves, hits are handled in CollisionReact
+}
 
 void Wall::Deserialize(const JSONData& source)
 {
@@ -43,6 +46,16 @@ void Wall::Deserialize(const JSONData& source)
 	m_isLosingWall = isLosing;
 }
 
+void Wall::WriteBinary(BinaryWriter& writer) const
+{
+	writer.Write(m_isLosingWall);
+}
+
+void Wall::ReadBinary(BinaryReader& reader)
+{
+	reader.Read(m_isLosingWall);
+}
+
 GameObject* Wall::Clone(World* parentWorld) const
 {
 	GameObject* clone = new Wall(GameObjectFactory::Get()->GenerateID(), parentWorld);
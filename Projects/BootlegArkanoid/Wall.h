@@ -37,10 +37,13 @@ private:
 
 	void Initialize(void) override {}
 	void Deserialize(const JSONData& source);
+	void WriteBinary(BinaryWriter& writer) const override;
+	void ReadBinary(BinaryReader& reader) override;
 
 	GameObject* Clone(World* parentWorld) const override;
 
 	void Update(float deltaTime) override {}
+	static constexpr bool HAS_UPDATE = false;
 	void ProcessInput(const InputMessage* msg) {}
 
 	const std::string& GetObjectTypeName(void) const override;
@@ -16,12 +16,12 @@
 #ifndef COLORDEFINITIONS_H
 #define COLORDEFINITIONS_H
 
-#define RED { 1.0f, 0.0f, 0.0f }
-#define GREEN { 0.0f, 1.0f, 0.0f }
-#define BLUE  { 0.0f, 0.0f, 1.0f }
-#define DARK_GREY { 0.3f, 0.3f, 0.3f }
-#define LIGHT_GREY { 0.6f, 0.6f, 0.6f }
-#define BRIGHT_GREEN { 0.25f, 0.9f, 0.25f }
-#define MEDIUM_GREEN { 0.25f, 0.55f, 0.25f }
+#define RED 1.0f, 0.0f, 0.0f
+#define GREEN 0.0f, 1.0f, 0.0f
+#define BLUE  0.0f, 0.0f, 1.0f
+#define DARK_GREY 0.3f, 0.3f, 0.3f
+#define LIGHT_GREY 0.6f, 0.6f, 0.6f
+#define BRIGHT_GREEN 0.25f, 0.9f, 0.25f
+#define MEDIUM_GREEN 0.25f, 0.55f, 0.25f
 
 #endif
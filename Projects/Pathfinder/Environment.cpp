@@ -14,6 +14,7 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "Environment.h"
+#include "Profiler.h"
 #include <fstream>
 
 constexpr int MIN_LINE_SIZE = 3;
@@ -29,6 +30,7 @@ Environment::~Environment(void)
 
 bool Environment::Initialize(const std::string& filename)
 {
+	PROFILE_SCOPE("Environment::Initialize");
 	if (m_isInitialized)
 	{
 		Clear();
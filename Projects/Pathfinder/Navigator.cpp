@@ -217,10 +217,10 @@ bool Navigator::DisplayNavigationProcess(float deltaTime, float actionTime)
 					switch (iter.m_isClosedList)
 					{
 					case true:
-						ChangeTileColor(iter.m_tilePtr, MEDIUM_GREEN);
+						ChangeTileColor(iter.m_tilePtr, Vector3(MEDIUM_GREEN));
 						break;
 					case false:
-						ChangeTileColor(iter.m_tilePtr, BRIGHT_GREEN);
+						ChangeTileColor(iter.m_tilePtr, Vector3(BRIGHT_GREEN));
 						break;
 					}
 				}
@@ -39,6 +39,7 @@ private:
 	GameObject* Clone(World* parentWorld) const override;
 
 	void Update(float deltaTime) override {}
+	static constexpr bool HAS_UPDATE = false;
 
 	const std::string& GetObjectTypeName(void) const override;
 	static const std::string& GetClassTypeName(void);
@@ -28,6 +28,7 @@
 #include "Shapes.h"
 #include "ColorDefinitions.h"
 #include "MessageFileRequest.h"
+#include "Profiler.h"
 #include "StringUtility.h"
 #include <imgui.h>
 
@@ -76,7 +77,7 @@ namespace MapDebug {
 
 PathfinderSystem::PathfinderSystem(App* app, GameObjectFactory* GOF)
 	: GameplaySystem(app, GOF)
-	, m_tileScale({ -1.0f, -1.0f, 0.0f })
+	, m_tileScale(-1.0f, -1.0f, 0.0f)
 	, m_agent(nullptr)
 	, m_appPtr(nullptr)
 {}
@@ -103,6 +104,11 @@ bool PathfinderSystem::Initialize(INIReader* ini)
 	return GameplaySystem::Initialize(ini);
 }
 
+const char* PathfinderSystem::GetName(void) const
+{
+	return "PathfinderSystem";
+}
+
 namespace UIState
 {
 	static const struct Defaults
@@ -179,7 +185,7 @@ namespace UIText
 	}
 }
 
-void PathfinderSystem::Update(float deltaTime)
+void PathfinderSystem::UpdateUI(float deltaTime)
 {
 	if (UIState::showMain)
 	{
@@ -305,7 +311,10 @@ void PathfinderSystem::Update(float deltaTime)
 
 		ImGui::End();
 	}
+}
 
+void PathfinderSystem::Update(float deltaTime)
+{
 	if (PFState::start)
 	{
 		static bool pathfinderMapFileLoaded = false;
@@ -332,6 +341,11 @@ void PathfinderSystem::Update(float deltaTime)
 		}
 		if (!pathfinderObjectsFinalized)
 		{
+			if (!AreGraphicsInitialized(m_GOF->GetObjectList()))
+			{
+				return; // tiles wait for their material replies
+			}
+
 			int numLines = m_environment.GetNumLines();
 			int numCols = m_environment.GetNumColumns();
 			int numTiles = numLines * numCols;
@@ -493,6 +507,7 @@ void PathfinderSystem::LoadPathfinderMap(const std::string& path)
 
 void PathfinderSystem::PopulateWorld(World* world)
 {
+	PROFILE_SCOPE("PathfinderSystem::PopulateWorld");
 	if (!m_environment.IsInitialized())
 	{
 		fprintf(stderr, "PathfinderSystem::%s: environment not initialized.", __func__);
@@ -523,31 +538,34 @@ void PathfinderSystem::PopulateWorld(World* world)
 	float xOffset = -(tileHalfExtents * (numColsFL - 1.0f));
 	float yOffset = tileHalfExtents * (numLinesFL - 1.0f);
 	
-	for (int line = 0; line < numLines; ++line)
+	// Create all tiles in one batch, place each tile by its index in the map
+	size_t numTiles = static_cast<size_t>(numLines) * static_cast<size_t>(numCols);
+	std::vector<PFTile*> tiles;
+	m_GOF->CreateNewObjects<PFTile>(numTiles, world, tiles, [&](PFTile* tile, size_t index)
 	{
-		for (int col = 0; col < numCols; ++col)
-		{
-			float tilePosX = xOffset + col * tileScale;
-			float tilePosY = yOffset - line * tileScale;
-			Vector3 tilePosition = { tilePosX, tilePosY };
-
-			PFTile* tile = m_GOF->CreateNewObject<PFTile>(world);
-			std::vector<SceneComponent*> sceneComps;
-			tile->QueryComponents(sceneComps);
-			Transform& tr = sceneComps[0]->GetTransform();
-			tr.SetScale({ tileScaleFL, tileScaleFL, 0.0f });
-			tr.SetPosition(tilePosition);
-
-			std::vector<PhysicsComponent*> physComps;
-			tile->QueryComponents(physComps);
-			AABB& colliderShape = static_cast<AABB&>(physComps[0]->GetColliderShape());
-			colliderShape.m_halfExtents = { tileHalfExtents, tileHalfExtents };
-			colliderShape.m_center = tilePosition;
-			colliderShape.m_previousCenter = tilePosition;
-
-			m_environment.m_map[line][col].m_tileObjectPtr = tile;
-		}
-	}
+		int line = static_cast<int>(index) / numCols;
+		int col = static_cast<int>(index) % numCols;
+
+		float tilePosX = xOffset + col * tileScale;
+		float tilePosY = yOffset - line * tileScale;
+		Vector3 tilePosition = { tilePosX, tilePosY };
+
+		std::vector<SceneComponent*> sceneComps;
+		tile->QueryComponents(sceneComps);
+		Transform& tr = sceneComps[0]->GetTransform();
+		tr.SetScale({ tileScaleFL, tileScaleFL, 0.0f });
+		tr.SetPosition(tilePosition);
+
+		std::vector<PhysicsComponent*> physComps;
+		tile->QueryComponents(physComps);
+		AABB& colliderShape = static_cast<AABB&>(physComps[0]->GetColliderShape());
+		colliderShape.m_halfExtents = { tileHalfExtents, tileHalfExtents };
+		colliderShape.m_center = tilePosition;
+		colliderShape.m_previousCenter = tilePosition;
+		tile->SetDormant(true);	// map tiles never move, only their color changes. The agent is a PFTile as well and moves
+
+		m_environment.m_map[line][col].m_tileObjectPtr = tile;
+	});
 
 	// Add agent object to the map
 	float agentPosX = xOffset + static_cast<float>(m_environment.m_agent.m_currentPos.m_column * tileScale);
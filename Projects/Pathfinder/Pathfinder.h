@@ -28,7 +28,9 @@ public:
 
 	bool Initialize(INIReader* ini) override final;
 	void Update(float deltaTime) override final;
+	void UpdateUI(float deltaTime) override final;	// map and search selection
 	void Exit(void) override final;
+	const char* GetName(void) const override final;
 
 	void RegisterMessages(void) override final;
 	void ProcessMessage(const Message* message) override final;